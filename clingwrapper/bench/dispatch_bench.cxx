@@ -0,0 +1,216 @@
+// Microbenchmarks of the call dispatch overhead of the backend: reports the
+// time and the number of heap allocations per call for each call type code,
+// argument count, object construction/destruction, and string returns.
+//
+// usage: cppyy-backend-bench [iterations]
+
+// Bindings
+#include "capi.h"
+#include "cpp_cppyy.h"
+
+// Standard
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+// allocation counting -------------------------------------------------------
+// with glibc, malloc itself is replaced, which covers operator new as well as
+// direct uses of malloc (e.g. by CallS); elsewhere only operator new is counted
+static std::atomic<size_t> gAllocs{0};
+
+#if defined(__GLIBC__)
+extern "C" void* __libc_malloc(size_t);
+extern "C" void* malloc(size_t sz) {
+    gAllocs.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(sz);
+}
+#endif
+
+void* operator new(size_t sz) {
+#if !defined(__GLIBC__)
+    gAllocs.fetch_add(1, std::memory_order_relaxed);
+#endif
+    if (void* p = malloc(sz ? sz : 1))
+        return p;
+    throw std::bad_alloc{};
+}
+
+void* operator new[](size_t sz) {
+    return ::operator new(sz);
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+
+// benchmark code and driver -------------------------------------------------
+static const int MAX_ARGS = SMALL_ARGS_N + 4;
+
+static std::string bench_code()
+{
+    std::ostringstream s;
+    s << "namespace cppyy_bench {\n"
+         "unsigned char fB() { return 1; }\n"
+         "char          fC() { return 'c'; }\n"
+         "short         fH() { return 2; }\n"
+         "int           fI() { return 3; }\n"
+         "long          fL() { return 4; }\n"
+         "long long     fLL() { return 5; }\n"
+         "float         fF() { return 6.f; }\n"
+         "double        fD() { return 7.; }\n"
+         "long double   fLD() { return 8.; }\n"
+         "void*         fR() { return nullptr; }\n"
+         "void          fV() {}\n"
+         "std::string   fS() { return \"dispatch\"; }\n"
+         "struct Vec3 { double x, y, z; };\n"
+         "Vec3          fO(double d) { return Vec3{d, d, d}; }\n"
+         "struct Obj { Obj(int i) : fI(i) {} ~Obj() { fI = 0; } int fI; };\n";
+    for (int n = 0; n <= MAX_ARGS; ++n) {
+        s << "long nargs" << n << "(";
+        for (int i = 0; i < n; ++i)
+            s << (i ? ", " : "") << "long a" << i;
+        s << ") { return 0";
+        for (int i = 0; i < n; ++i)
+            s << " + a" << i;
+        s << "; }\n";
+    }
+    s << "}\n";
+    return s.str();
+}
+
+static Cppyy::TCppMethod_t find_method(Cppyy::TCppScope_t scope, const std::string& name)
+{
+    std::vector<Cppyy::TCppMethod_t> methods = Cppyy::GetMethodsFromName(scope, name);
+    if (methods.empty()) {
+        fprintf(stderr, "cppyy-backend-bench: method %s not found\n", name.c_str());
+        exit(1);
+    }
+    return methods[0];
+}
+
+template<typename F>
+static void run(const char* label, size_t iterations, F f)
+{
+// warm up (JIT-ing of wrappers, pool and slab fill), then measure
+    for (size_t i = 0; i < 100; ++i) f();
+
+    size_t allocs = gAllocs.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) f();
+    auto stop = std::chrono::steady_clock::now();
+    allocs = gAllocs.load(std::memory_order_relaxed) - allocs;
+
+    double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+    printf("%-28s %10.1f ns/call %8.2f allocs/call\n",
+        label, ns/iterations, (double)allocs/iterations);
+}
+
+int main(int argc, char** argv)
+{
+    size_t iterations = 1000000;
+    if (argc > 1) iterations = (size_t)strtoull(argv[1], nullptr, 10);
+
+    if (!Cppyy::Compile(bench_code())) {
+        fprintf(stderr, "cppyy-backend-bench: failed to declare benchmark code\n");
+        return 1;
+    }
+    Cppyy::TCppScope_t scope = Cppyy::GetScope("cppyy_bench");
+
+// call per type code, without arguments
+    {
+        Cppyy::TCppMethod_t m;
+#define CPPYY_BENCH_CALL(typecode)                                           \
+        m = find_method(scope, "f" #typecode);                               \
+        run("Call" #typecode, iterations, [m] { Cppyy::Call##typecode(m, nullptr, 0, nullptr); });
+        CPPYY_BENCH_CALL(B)
+        CPPYY_BENCH_CALL(C)
+        CPPYY_BENCH_CALL(H)
+        CPPYY_BENCH_CALL(I)
+        CPPYY_BENCH_CALL(L)
+        CPPYY_BENCH_CALL(LL)
+        CPPYY_BENCH_CALL(F)
+        CPPYY_BENCH_CALL(D)
+        CPPYY_BENCH_CALL(LD)
+        CPPYY_BENCH_CALL(R)
+        CPPYY_BENCH_CALL(V)
+#undef CPPYY_BENCH_CALL
+    }
+
+// argument counts, through the generic wrapper and the direct path
+    for (int n = 0; n <= MAX_ARGS; ++n) {
+        Cppyy::TCppMethod_t m = find_method(scope, "nargs" + std::to_string(n));
+        std::vector<Parameter> args(n ? n : 1);
+        for (int i = 0; i < n; ++i) {
+            args[i].fValue.fLong = i;
+            args[i].fTypeCode = 'l';
+        }
+        Parameter* a = args.data();
+        std::string label = "CallL, " + std::to_string(n) + " args";
+        run(label.c_str(), iterations, [m, n, a] { Cppyy::CallL(m, nullptr, n, a); });
+        label += ", direct";
+        run(label.c_str(), iterations, [m, n, a] { Cppyy::CallL(m, nullptr, n | DIRECT_CALL, a); });
+    }
+
+// object construction and destruction
+    {
+        Cppyy::TCppScope_t klass = Cppyy::GetScope("Obj", scope);
+        Cppyy::TCppMethod_t ctor = nullptr;
+        for (auto m : Cppyy::GetClassMethods(klass)) {
+            if (Cppyy::IsConstructor(m) && Cppyy::GetMethodNumArgs(m) == 1) { ctor = m; break; }
+        }
+        if (!ctor) {
+            fprintf(stderr, "cppyy-backend-bench: constructor Obj(int) not found\n");
+            return 1;
+        }
+        Parameter arg;
+        arg.fValue.fInt = 42;
+        arg.fTypeCode = 'i';
+        run("CallConstructor/Destructor", iterations, [ctor, klass, &arg] {
+            Cppyy::TCppObject_t obj = Cppyy::CallConstructor(ctor, klass, 1, &arg);
+            Cppyy::CallDestructor(klass, obj);
+            Cppyy::ReleaseObject(klass, obj);
+        });
+    }
+
+// string returns
+    {
+        Cppyy::TCppMethod_t m = find_method(scope, "fS");
+        run("CallS", iterations, [m] {
+            size_t len = 0;
+            free(Cppyy::CallS(m, nullptr, 0, nullptr, &len));
+        });
+        run("CallStdString", iterations, [m] {
+            Cppyy::FreeStdString(Cppyy::CallStdString(m, nullptr, 0, nullptr));
+        });
+        char* buffer = nullptr; size_t capacity = 0;
+        run("CallSBuffer", iterations, [m, &buffer, &capacity] {
+            Cppyy::CallSBuffer(m, nullptr, 0, nullptr, &buffer, &capacity);
+        });
+        free(buffer);
+    }
+
+// by-value returns
+    {
+        Cppyy::TCppMethod_t m = find_method(scope, "fO");
+        Cppyy::TCppType_t rtype = Cppyy::GetMethodReturnType(m);
+        Cppyy::TCppScope_t klass = Cppyy::GetScope("Vec3", scope);
+        Parameter arg;
+        arg.fValue.fDouble = 1.;
+        arg.fTypeCode = 'd';
+        run("CallO", iterations, [m, rtype, klass, &arg] {
+            Cppyy::TCppObject_t obj = Cppyy::CallO(m, nullptr, 1, &arg, rtype);
+            Cppyy::CallDestructor(klass, obj);
+            Cppyy::ReleaseObject(klass, obj);
+        });
+    }
+
+    return 0;
+}
@@ -17,6 +17,7 @@ extern "C" {
 
     typedef size_t        cppyy_index_t;
     typedef void*         cppyy_funcaddr_t;
+    typedef void*         cppyy_names_cursor_t;
 
     typedef unsigned long cppyy_exctype_t;
 
@@ -27,6 +28,29 @@ extern "C" {
     int cppyy_compile_silent(const char* code);
     RPY_EXPORTED
     char* cppyy_to_string(cppyy_type_t klass, cppyy_object_t obj);
+    /* headers loaded on demand (CPPYY_LAZY_HEADERS), one per line: header, the
+       name that triggered the load and the time since startup in seconds */
+    RPY_EXPORTED
+    char* cppyy_lazy_header_report();
+    /* startup phases: ApplicationStarter records its own, the Python loader adds
+       its phases (start in seconds since the epoch, duration in seconds); the
+       report has one line per phase: name, start and duration in milliseconds,
+       with start relative to the earliest phase; CPPYY_STARTUP_TRACE prints it
+       on exit */
+    RPY_EXPORTED
+    void cppyy_startup_record(const char* phase, double start, double duration);
+    RPY_EXPORTED
+    char* cppyy_startup_report();
+    /* with CPPYY_ASYNC_INIT, start initializing the interpreter on a background
+       thread and return right away (otherwise, the first call that needs it runs
+       the initialization); to be called once the library is loaded, not from a
+       static initializer; before it completes, only calls that take names (which
+       wait for it) and those that do not touch the interpreter (interning of
+       strings, startup and profiling reports, scratch memory) are safe, as all
+       handles come from the former; debug builds assert this on the call,
+       reflection, and base offset paths */
+    RPY_EXPORTED
+    void cppyy_start_interpreter();
 
     /* name to opaque C++ scope representation -------------------------------- */
     RPY_EXPORTED
@@ -56,6 +80,13 @@ extern "C" {
     cppyy_object_t cppyy_construct(cppyy_type_t type);
     RPY_EXPORTED
     void cppyy_destruct(cppyy_type_t type, cppyy_object_t self);
+    /* return the memory of a destructed object from construct/call_o to the pool;
+       a no-op for classes with their own operator new, which are not pooled (free
+       those with cppyy_destruct, or results of call_o with cppyy_deallocate) */
+    RPY_EXPORTED
+    void cppyy_release_object(cppyy_type_t type, cppyy_object_t self);
+    RPY_EXPORTED
+    void cppyy_object_pool_stats(size_t* allocs, size_t* reuses, size_t* releases, size_t* cached);
 
     /* method/function dispatching -------------------------------------------- */
     RPY_EXPORTED
@@ -85,6 +116,16 @@ extern "C" {
     void* cppyy_call_r(cppyy_method_t method, cppyy_object_t self, int nargs, void* args);
     RPY_EXPORTED
     char* cppyy_call_s(cppyy_method_t method, cppyy_object_t self, int nargs, void* args, size_t* length);
+    /* string result without copies: the returned std::string is owned by the
+       caller (read with cppyy_stdstring2charp, release with cppyy_free_stdstring) */
+    RPY_EXPORTED
+    cppyy_object_t cppyy_call_stdstring(cppyy_method_t method, cppyy_object_t self, int nargs, void* args);
+    RPY_EXPORTED
+    void cppyy_free_stdstring(cppyy_object_t str);
+    /* string result into a reusable, malloc'ed buffer that is grown as needed;
+       returns the length, or (size_t)-1 if the call or the allocation failed */
+    RPY_EXPORTED
+    size_t cppyy_call_s_buffer(cppyy_method_t method, cppyy_object_t self, int nargs, void* args, char** buffer, size_t* capacity);
     RPY_EXPORTED
     cppyy_object_t cppyy_constructor(cppyy_method_t method, cppyy_type_t klass, int nargs, void* args);
     RPY_EXPORTED
@@ -92,14 +133,52 @@ extern "C" {
     RPY_EXPORTED
     cppyy_object_t cppyy_call_o(cppyy_method_t method, cppyy_object_t self, int nargs, void* args, cppyy_type_t result_type);
 
+
+    /* batched: method over count receivers (selves may be NULL) and count
+       contiguous rows of nargs arguments, with results[i] for row i; returns 0
+       if the method could not be resolved (then nothing was called) */
+    RPY_EXPORTED
+    int cppyy_call_v_batch(cppyy_method_t method, cppyy_object_t* selves, int nargs, void* args, size_t count);
+    RPY_EXPORTED
+    int cppyy_call_b_batch(cppyy_method_t method, cppyy_object_t* selves, int nargs, void* args, unsigned char* results, size_t count);
+    RPY_EXPORTED
+    int cppyy_call_c_batch(cppyy_method_t method, cppyy_object_t* selves, int nargs, void* args, char* results, size_t count);
+    RPY_EXPORTED
+    int cppyy_call_h_batch(cppyy_method_t method, cppyy_object_t* selves, int nargs, void* args, short* results, size_t count);
+    RPY_EXPORTED
+    int cppyy_call_i_batch(cppyy_method_t method, cppyy_object_t* selves, int nargs, void* args, int* results, size_t count);
+    RPY_EXPORTED
+    int cppyy_call_l_batch(cppyy_method_t method, cppyy_object_t* selves, int nargs, void* args, long* results, size_t count);
+    RPY_EXPORTED
+    int cppyy_call_ll_batch(cppyy_method_t method, cppyy_object_t* selves, int nargs, void* args, long long* results, size_t count);
+    RPY_EXPORTED
+    int cppyy_call_f_batch(cppyy_method_t method, cppyy_object_t* selves, int nargs, void* args, float* results, size_t count);
+    RPY_EXPORTED
+    int cppyy_call_d_batch(cppyy_method_t method, cppyy_object_t* selves, int nargs, void* args, double* results, size_t count);
+    RPY_EXPORTED
+    int cppyy_call_ld_batch(cppyy_method_t method, cppyy_object_t* selves, int nargs, void* args, long double* results, size_t count);
+    RPY_EXPORTED
+    int cppyy_call_r_batch(cppyy_method_t method, cppyy_object_t* selves, int nargs, void* args, void** results, size_t count);
+
     RPY_EXPORTED
     cppyy_funcaddr_t cppyy_function_address(cppyy_method_t method);
+    /* drop the memoized wrapper of method (of all methods if 0), to be called
+       when declarations are unloaded; the memory is not reclaimed until exit */
+    RPY_EXPORTED
+    void cppyy_invalidate_callables(cppyy_method_t method);
 
     /* handling of function argument buffer ----------------------------------- */
     RPY_EXPORTED
     void* cppyy_allocate_function_args(int nargs);
     RPY_EXPORTED
     void cppyy_deallocate_function_args(void* args);
+    /* temporaries passed with type code 'T'; released after the receiving call
+       (also if it throws); reset drops all of them, and is a no-op (asserts in
+       debug builds) while calls are in progress on the calling thread */
+    RPY_EXPORTED
+    void* cppyy_call_scratch_alloc(size_t size);
+    RPY_EXPORTED
+    void cppyy_call_scratch_reset();
     RPY_EXPORTED
     size_t cppyy_function_arg_sizeof();
     RPY_EXPORTED
@@ -108,6 +187,96 @@ extern "C" {
     /* scope reflection information ------------------------------------------- */
     RPY_EXPORTED
     int cppyy_is_namespace(cppyy_scope_t scope);
+
+    /* bulk class description: one flat record per scope, consisting of a header,
+       arrays of fixed-size entries at the given offsets (from the start of the
+       record), and a table of null-terminated strings, which all name, type, etc.
+       fields index into (offset 0 is the empty string); release with cppyy_free;
+       enums are not included (use cppyy_get_enum), as finding them would take a
+       lookup of every name in the scope */
+#define CPPYY_CLASS_DESC_MAGIC   0x44595043     /* "CPYD" */
+#define CPPYY_CLASS_DESC_VERSION 2
+
+#define CPPYY_DESC_PUBLIC        0x0001
+#define CPPYY_DESC_PROTECTED     0x0002
+#define CPPYY_DESC_PRIVATE       0x0004
+#define CPPYY_DESC_STATIC        0x0008
+#define CPPYY_DESC_CONST         0x0010
+#define CPPYY_DESC_CONSTRUCTOR   0x0020
+#define CPPYY_DESC_DESTRUCTOR    0x0040
+#define CPPYY_DESC_DELETED       0x0080
+#define CPPYY_DESC_TEMPLATE      0x0100
+#define CPPYY_DESC_NAMESPACE     0x0200
+#define CPPYY_DESC_ABSTRACT      0x0400
+
+    typedef struct {
+        uint32_t       magic;
+        uint32_t       version;
+        uint32_t       size;            /* of the full record, in bytes */
+        uint32_t       flags;
+        cppyy_scope_t  scope;
+        uint64_t       sizeof_class;
+        uint32_t       name;
+        uint32_t       nmethods,     methods;       /* cppyy_method_desc_t[] */
+        uint32_t       nargs,        args;          /* cppyy_arg_desc_t[] */
+        uint32_t       ndatamembers, datamembers;   /* cppyy_data_desc_t[] */
+        uint32_t       nbases,       bases;         /* cppyy_base_desc_t[] */
+        uint32_t       strings,      strings_size;
+    } cppyy_class_desc_t;
+
+    typedef struct {
+        cppyy_method_t method;
+        uint32_t       name;
+        uint32_t       rtype;
+        uint32_t       signature;
+        uint32_t       flags;
+        uint32_t       nargs;
+        uint32_t       nreq;
+        uint32_t       first_arg;       /* index into args */
+        uint32_t       reserved;
+    } cppyy_method_desc_t;
+
+    typedef struct {
+        uint32_t       name;
+        uint32_t       type;
+        uint32_t       defvalue;
+    } cppyy_arg_desc_t;
+
+    typedef struct {
+        cppyy_scope_t  handle;
+        int64_t        offset;
+        uint32_t       name;
+        uint32_t       type;
+        uint32_t       flags;
+        uint32_t       reserved;
+    } cppyy_data_desc_t;
+
+    typedef struct {
+        cppyy_scope_t  handle;
+        uint32_t       name;
+        uint32_t       reserved;
+    } cppyy_base_desc_t;
+
+    RPY_EXPORTED
+    int cppyy_describe_class(cppyy_scope_t scope, char** buf, size_t* len);
+
+    /* persistent reflection cache: class description records, by scoped name, in
+       a file that is memory-mapped read-only and shared across processes; it is
+       keyed by the interpreter flags and the contents of the dependency files, and
+       ignored (then replaced on save) if the key does not match; handles in the
+       stored records are zero; records found are copies, to be freed by the caller
+       as with cppyy_describe_class; opening fails if the interpreter was created
+       elsewhere, as its flags are then unknown */
+    RPY_EXPORTED
+    int cppyy_reflection_cache_open(const char* path, const char** deps, size_t ndeps);
+    RPY_EXPORTED
+    void cppyy_reflection_cache_close();
+    RPY_EXPORTED
+    int cppyy_reflection_cache_find(const char* name, char** buf, size_t* len);
+    RPY_EXPORTED
+    int cppyy_reflection_cache_add(cppyy_scope_t scope);
+    RPY_EXPORTED
+    int cppyy_reflection_cache_save();
     RPY_EXPORTED
     int cppyy_is_template(const char* template_name);
     RPY_EXPORTED
@@ -122,6 +291,16 @@ extern "C" {
     RPY_EXPORTED
     const char** cppyy_get_all_cpp_names(cppyy_scope_t scope, size_t* count);
 
+    /* iterate over the names in scope that start with prefix (may be NULL), in
+       sorted order; cppyy_names_next returns NULL at the end, and the returned
+       names remain valid until the cursor is closed */
+    RPY_EXPORTED
+    cppyy_names_cursor_t cppyy_names_open(cppyy_scope_t scope, const char* prefix);
+    RPY_EXPORTED
+    const char* cppyy_names_next(cppyy_names_cursor_t cursor);
+    RPY_EXPORTED
+    void cppyy_names_close(cppyy_names_cursor_t cursor);
+
     /* namespace reflection information --------------------------------------- */
     RPY_EXPORTED
     cppyy_index_t* cppyy_get_using_namespaces(cppyy_scope_t scope);
@@ -254,6 +433,23 @@ extern "C" {
     RPY_EXPORTED
     int cppyy_get_dimension_size(cppyy_scope_t scope, cppyy_index_t idata, int dimension);
 
+    /* datamember layout of a completed class: one entry per datamember, owned by
+       the backend and valid for the remainder of the process; NULL otherwise */
+    typedef struct {
+        cppyy_scope_t  handle;
+        const char*    name;            /* interned */
+        intptr_t       offset;          /* address for static data */
+        size_t         size;            /* of the member's type */
+        const long*    dims;            /* array dimensions, ndims of them */
+        uint32_t       ndims;
+        unsigned char  is_static;
+        unsigned char  is_const;
+        char           kind;            /* fast path type code, 0 if none */
+    } cppyy_datamember_layout_t;
+
+    RPY_EXPORTED
+    const cppyy_datamember_layout_t* cppyy_datamember_layout(cppyy_scope_t scope, size_t* count);
+
     /* enum properties -------------------------------------------------------- */
     RPY_EXPORTED
     cppyy_enum_t  cppyy_get_enum(cppyy_scope_t scope, const char* enum_name);
@@ -264,6 +460,55 @@ extern "C" {
     RPY_EXPORTED
     long long     cppyy_get_enum_data_value(cppyy_enum_t, cppyy_index_t idata);
 
+    /* call profiling --------------------------------------------------------- */
+#define CPPYY_PROFILE_BUCKETS 32
+    typedef struct {
+        char*              name;            /* full method name */
+        unsigned long long calls;
+        unsigned long long total_ns;
+        unsigned long long histogram[CPPYY_PROFILE_BUCKETS];   /* bucket i: latency < 2^i ns */
+    } cppyy_profile_t;
+
+    RPY_EXPORTED
+    void cppyy_profile_enable(int enable);
+    RPY_EXPORTED
+    cppyy_profile_t* cppyy_profile_snapshot(size_t* count);
+    RPY_EXPORTED
+    void cppyy_profile_free(cppyy_profile_t* entries, size_t count);
+    RPY_EXPORTED
+    void cppyy_profile_reset();
+
+    /* interned strings: valid for the lifetime of the process, never to be freed,
+       and equal strings have equal pointers ----------------------------------- */
+    RPY_EXPORTED
+    const char* cppyy_intern(const char* str);
+    RPY_EXPORTED
+    const char* cppyy_resolve_name_interned(const char* cppitem_name);
+    RPY_EXPORTED
+    const char* cppyy_final_name_interned(cppyy_type_t type);
+    RPY_EXPORTED
+    const char* cppyy_scoped_final_name_interned(cppyy_type_t type);
+    RPY_EXPORTED
+    const char* cppyy_base_name_interned(cppyy_type_t type, int base_index);
+    RPY_EXPORTED
+    const char* cppyy_method_name_interned(cppyy_method_t method);
+    RPY_EXPORTED
+    const char* cppyy_method_full_name_interned(cppyy_method_t method);
+    RPY_EXPORTED
+    const char* cppyy_method_result_type_interned(cppyy_method_t method);
+    RPY_EXPORTED
+    const char* cppyy_method_arg_name_interned(cppyy_method_t method, int arg_index);
+    RPY_EXPORTED
+    const char* cppyy_method_arg_type_interned(cppyy_method_t method, int arg_index);
+    RPY_EXPORTED
+    const char* cppyy_method_arg_default_interned(cppyy_method_t method, int arg_index);
+    RPY_EXPORTED
+    const char* cppyy_method_signature_interned(cppyy_method_t method, int show_formal_args);
+    RPY_EXPORTED
+    const char* cppyy_datamember_name_interned(cppyy_scope_t var);
+    RPY_EXPORTED
+    const char* cppyy_datamember_type_interned(cppyy_scope_t var);
+
     /* misc helpers ----------------------------------------------------------- */
     RPY_EXPORTED
     long long cppyy_strtoll(const char* str);
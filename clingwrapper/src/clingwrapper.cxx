@@ -10,21 +10,37 @@
 #include "cpp_cppyy.h"
 #include "callcontext.h"
 
+#include <cxxabi.h>
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // Standard
 #include <assert.h>
 #include <algorithm>     // for std::count, std::remove
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
 #include <stdexcept>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <new>
 #include <regex>
 #include <set>
+#include <shared_mutex>
 #include <sstream>
 #include <signal.h>
 #include <stdlib.h>      // for getenv
 #include <string.h>
+#include <thread>
 #include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
 #include <iostream>
 
 
@@ -82,6 +98,76 @@ static std::set<std::string> gRootSOs;
 
 // configuration
 static bool gEnableFastPath = true;
+static std::string gInterpFlags;      // empty if the interpreter was not ours to create
+static std::atomic<bool> gProfiling{false};
+static bool gStartupTrace = false;
+
+// set once the interpreter is fully initialized; with CPPYY_ASYNC_INIT, that is
+// deferred until Cppyy::StartInterpreter runs it on a background thread, or else
+// until the first entry point that maps names to handles (which all others depend
+// on) runs it inline; those entry points wait for it
+static std::atomic<bool> gInterpReady{false};
+static std::mutex gInterpReadyLock;
+static std::condition_variable gInterpReadyCond;
+
+static void start_interpreter(bool async);
+
+static inline void wait_for_interpreter()
+{
+    if (gInterpReady.load(std::memory_order_acquire))
+        return;
+    start_interpreter(/*async=*/false);
+    std::unique_lock<std::mutex> lock(gInterpReadyLock);
+    gInterpReadyCond.wait(lock, [] { return gInterpReady.load(std::memory_order_acquire); });
+}
+
+// entry points that take handles can only be reached after one of the above has
+// produced those handles; checked in debug builds where all calls, method indices,
+// base offsets, and class descriptions pass through
+static inline void assert_interpreter_ready()
+{
+    assert(gInterpReady.load(std::memory_order_acquire) && "handle used before the interpreter was started");
+}
+
+static void set_interpreter_ready()
+{
+    {
+        std::lock_guard<std::mutex> lock(gInterpReadyLock);
+        gInterpReady.store(true, std::memory_order_release);
+    }
+    gInterpReadyCond.notify_all();
+}
+
+// bumped whenever new declarations may have become visible to lookups
+static std::atomic<uint64_t> gDeclGeneration{0};
+// bumped only when user code (incl. headers) was declared, as opposed to the
+// backend's own helpers, which add no names beyond those of instantiations
+static std::atomic<uint64_t> gNameGeneration{0};
+
+// standard headers that are loaded at startup or, with CPPYY_LAZY_HEADERS set,
+// only when a lookup in std fails, selected by the (outer) name looked up; also
+// loaded are all of them when the names of std are listed, and those of the std
+// names that compiled code mentions qualified (or all of them if it has a using
+// directive for std); names it uses otherwise, e.g. through ADL or a using
+// declaration of std itself, are not seen and need a prior lookup
+// FIXME: Replace with modules
+static const struct { const char* fHeader; const char* fNames; } g_std_headers[] = {
+    {"<iostream>", " cout cerr clog cin endl flush ios ios_base istream ostream iostream "},
+    {"<map>",      " map multimap "},
+    {"<sstream>",  " stringstream istringstream ostringstream basic_stringstream "},
+    {"<array>",    " array "},
+    {"<list>",     " list "},
+    {"<deque>",    " deque "},
+    {"<tuple>",    " tuple make_tuple tie get tuple_size tuple_element "},
+    {"<set>",      " set multiset "},
+    {"<chrono>",   " chrono "},
+    {"<cmath>",    " abs fabs sqrt pow exp log log10 sin cos tan floor ceil round "}};
+static const size_t N_STD_HEADERS = sizeof(g_std_headers)/sizeof(g_std_headers[0]);
+
+static std::atomic<bool> gLazyHeadersPending{false};
+static bool gLazyHeadersVerbose = false;
+static Cppyy::TCppScope_t gStdScope = nullptr;
+static std::chrono::steady_clock::time_point gStartTime = std::chrono::steady_clock::now();
 
 
 // global initialization -----------------------------------------------------
@@ -125,6 +211,57 @@ static struct Signalmap_t {
    { SIGUSR2,   "user-defined signal 2" }
 };
 
+// startup phases, from ApplicationStarter and as reported by the Python loader;
+// start times are in seconds since the epoch, so that both sides agree
+struct StartupPhase {
+    std::string fName;
+    double      fStart;
+    double      fDuration;
+};
+
+static std::mutex gStartupLock;
+static std::vector<StartupPhase> gStartupPhases;
+
+static inline double epoch_seconds()
+{
+    return std::chrono::duration<double>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+static void record_startup_phase(const std::string& name, double start, double duration)
+{
+    std::lock_guard<std::mutex> lock(gStartupLock);
+    gStartupPhases.push_back(StartupPhase{name, start, duration});
+}
+
+class StartupTimer {
+public:
+    StartupTimer(const char* name) : fName(name), fStart(epoch_seconds()) {}
+    ~StartupTimer() { record_startup_phase(fName, fStart, epoch_seconds() - fStart); }
+
+private:
+    const char* fName;
+    double      fStart;
+};
+
+static std::string startup_report()
+{
+// one line per phase, in order of start: name, start relative to the earliest
+// phase, and duration, both in milliseconds
+    std::lock_guard<std::mutex> lock(gStartupLock);
+    std::vector<StartupPhase> phases = gStartupPhases;
+    std::stable_sort(phases.begin(), phases.end(),
+        [](const StartupPhase& a, const StartupPhase& b) { return a.fStart < b.fStart; });
+    std::ostringstream report;
+    report.setf(std::ios::fixed);
+    report.precision(3);
+    for (const StartupPhase& phase : phases) {
+        report << phase.fName << '\t' << (phase.fStart - phases.front().fStart)*1e3
+               << '\t' << phase.fDuration*1e3 << '\n';
+    }
+    return report.str();
+}
+
 // static void inline do_trace(int sig) {
 //     std::cerr << " *** Break *** " << (sig < kMAXSIGNALS ? gSignalMap[sig].fSigName : "") << std::endl;
 //     gSystem->StackTrace();
@@ -163,8 +300,38 @@ void push_tokens_from_string(char *s, std::vector <const char*> &tokens) {
 
 class ApplicationStarter {
   Cpp::TInterp_t Interp;
+  bool fDeferred = false;
+  std::thread fInitThread;
+  std::once_flag fStarted;
 public:
     ApplicationStarter() {
+    // optionally let the loading of the library return right away, and overlap
+    // the initialization with whatever the caller does next; no thread is started
+    // from here, as its own dlopen calls (e.g. for libstdc++) would wait for the
+    // loader lock, which is held while this constructor runs
+        if (getenv("CPPYY_ASYNC_INIT"))
+            fDeferred = true;
+        else
+            Initialize();
+    }
+
+    // run a deferred initialization, on a background thread if async, or else on
+    // the calling thread (which then needs no other thread to make progress)
+    void Start(bool async) {
+        std::call_once(fStarted, [this, async] {
+            if (!fDeferred)
+                return;
+            if (async)
+                fInitThread = std::thread([this] { Initialize(); });
+            else
+                Initialize();
+        });
+    }
+
+    void Initialize() {
+        StartupTimer total("ApplicationStarter");
+        std::unique_ptr<StartupTimer> phase(new StartupTimer("create interpreter"));
+
         // Check if somebody already loaded CppInterOp and created an
         // interpreter for us.
         if (auto * existingInterp = Cpp::GetInterpreter()) {
@@ -175,9 +342,14 @@ public:
             char *InterpArgString = getenv("CPPINTEROP_EXTRA_INTERPRETER_ARGS");
             if (InterpArgString)
                push_tokens_from_string(InterpArgString, InterpArgs);
-            Interp = Cpp::CreateInterpreter({"-std=c++17", "-march=native"});
+            for (const char* arg : InterpArgs)
+                gInterpFlags += std::string(arg) + ' ';
+            Interp = Cpp::CreateInterpreter(InterpArgs);
         }
 
+    // names known before any headers are loaded are not of interest to users
+        Cpp::GetAllCppNames(Cpp::GetGlobalScope(), gInitialNames);
+
         // fill out the builtins
         std::set<std::string> bi{g_builtins};
         for (const auto& name : bi) {
@@ -188,7 +360,11 @@ public:
     // disable fast path if requested
         if (getenv("CPPYY_DISABLE_FASTPATH")) gEnableFastPath = false;
 
+    // enable call profiling if requested
+        if (getenv("CPPYY_PROFILE")) gProfiling = true;
+
     // set opt level (default to 2 if not given; Cling itself defaults to 0)
+        phase.reset(new StartupTimer("optimize pragma"));
         int optLevel = 2;
 
         if (getenv("CPPYY_OPT_LEVEL")) optLevel = atoi(getenv("CPPYY_OPT_LEVEL"));
@@ -201,6 +377,7 @@ public:
 
         // This would give us something like:
         // /home/vvassilev/workspace/builds/scratch/cling-build/builddir/lib/clang/13.0.0
+        phase.reset(new StartupTimer("include paths"));
         const char * ResourceDir = Cpp::GetResourceDir();
         std::string ClingSrc = std::string(ResourceDir) + "/../../../../cling-src";
         std::string ClingBuildDir = std::string(ResourceDir) + "/../../../";
@@ -208,11 +385,12 @@ public:
         Cpp::AddIncludePath((ClingSrc + "/include").c_str());
         Cpp::AddIncludePath((ClingBuildDir + "/include").c_str());
         Cpp::AddIncludePath((std::string(CPPINTEROP_DIR) + "/include").c_str());
+        phase.reset(new StartupTimer("load libstdc++"));
         Cpp::LoadLibrary("libstdc++", /* lookup= */ true);
 
-        // load frequently used headers
+        // load the headers needed by the backend itself
+        phase.reset(new StartupTimer("core headers"));
         const char* code =
-               "#include <iostream>\n"
                "#include <string.h>\n" // for strcpy
                "#include <string>\n"
             //    "#include <DllImport.h>\n"     // defines R__EXTERN
@@ -220,19 +398,25 @@ public:
                "#include <utility>\n"
                "#include <memory>\n"
                "#include <functional>\n" // for the dispatcher code to use std::function
-               "#include <map>\n" // FIXME: Replace with modules
-               "#include <sstream>\n" // FIXME: Replace with modules
-               "#include <array>\n" // FIXME: Replace with modules
-               "#include <list>\n" // FIXME: Replace with modules
-               "#include <deque>\n" // FIXME: Replace with modules
-               "#include <tuple>\n" // FIXME: Replace with modules
-               "#include <set>\n" // FIXME: Replace with modules
-               "#include <chrono>\n" // FIXME: Replace with modules
-               "#include <cmath>\n" // FIXME: Replace with modules
                "#include \"clang/Interpreter/CppInterOp.h\"";
         Cpp::Process(code);
+        gStdScope = Cpp::GetScope("std", nullptr);
+
+    // and the frequently used ones, unless deferred to first use
+        const char* lazy = getenv("CPPYY_LAZY_HEADERS");
+        if (lazy && strcmp(lazy, "0") != 0) {
+            gLazyHeadersPending = true;
+            gLazyHeadersVerbose = strcmp(lazy, "verbose") == 0;
+        } else {
+            phase.reset(new StartupTimer("standard headers"));
+            std::string std_code;
+            for (const auto& h : g_std_headers)
+                std_code += std::string("#include ") + h.fHeader + "\n";
+            Cpp::Process(std_code.c_str());
+        }
 
     // create helpers for comparing thingies
+        phase.reset(new StartupTimer("helper declarations"));
         Cpp::Declare(
             "namespace __cppyy_internal { template<class C1, class C2>"
             " bool is_equal(const C1& c1, const C2& c2) { return (bool)(c1 == c2); } }");
@@ -266,9 +450,20 @@ public:
 
     // create an exception handler to process signals
         // gExceptionHandler = new TExceptionHandlerImp{};
+
+        phase.reset();
+        gStartupTrace = getenv("CPPYY_STARTUP_TRACE") != nullptr;
+        set_interpreter_ready();
     }
 
     ~ApplicationStarter() {
+        if (fInitThread.joinable())
+            fInitThread.join();
+
+    // summary includes the phases that the Python loader reported after startup
+        if (gStartupTrace)
+            std::cerr << "cppyy startup phases (name, start [ms], duration [ms]):\n"
+                      << startup_report() << std::flush;
       //Cpp::DeleteInterpreter(Interp);
         // for (auto wrap : gWrapperHolder)
         //     delete wrap;
@@ -278,6 +473,11 @@ public:
 
 } // unnamed namespace
 
+static void start_interpreter(bool async)
+{
+    _applicationStarter.Start(async);
+}
+
 
 // // local helpers -------------------------------------------------------------
 // static inline
@@ -320,11 +520,233 @@ char* cppstring_to_cstring(const std::string& cppstr)
 //
 //
 // // direct interpreter access -------------------------------------------------
+// Memoized name lookups, keyed on (kind, parent scope, name) and including the
+// failed ones. The cache is sharded, each shard a read-mostly map under a
+// shared lock. Anything that may add declarations bumps gDeclGeneration, and a
+// shard whose generation is behind is emptied on its next insertion; results
+// computed across a bump are not stored. Failures for template names are not
+// stored either, as instantiations happen as a side-effect of e.g. wrapper
+// generation and address lookups, which do not bump the generation.
+namespace {
+
+class LookupCache {
+public:
+    enum Kind : char { kScope = 's', kFullScope = 'f', kNamed = 'n', kType = 't' };
+
+    bool find(Kind kind, void* parent, const std::string& name, void*& result) {
+        Shard& s = shard(kind, parent, name);
+        std::shared_lock<std::shared_mutex> lock(s.fLock);
+        if (s.fGeneration != gDeclGeneration.load(std::memory_order_acquire))
+            return false;
+        auto scope = s.fEntries.find(ScopeKey{kind, parent});
+        if (scope == s.fEntries.end())
+            return false;
+        auto entry = scope->second.find(name);
+        if (entry == scope->second.end())
+            return false;
+        result = entry->second;
+        return true;
+    }
+
+    // generation is that of gDeclGeneration from before the lookup
+    void insert(Kind kind, void* parent, const std::string& name, void* result, uint64_t generation) {
+        if (!result && name.find('<') != std::string::npos)
+            return;
+        Shard& s = shard(kind, parent, name);
+        std::unique_lock<std::shared_mutex> lock(s.fLock);
+        if (generation != gDeclGeneration.load(std::memory_order_acquire))
+            return;
+        if (s.fGeneration != generation) {
+            s.fEntries.clear();
+            s.fGeneration = generation;
+        }
+        s.fEntries[ScopeKey{kind, parent}][name] = result;
+    }
+
+private:
+    struct ScopeKey {
+        Kind  fKind;
+        void* fParent;
+        bool operator==(const ScopeKey& other) const {
+            return fKind == other.fKind && fParent == other.fParent;
+        }
+    };
+
+    struct ScopeKeyHash {
+        size_t operator()(const ScopeKey& key) const {
+            return std::hash<void*>()(key.fParent) ^ ((size_t)key.fKind << 1);
+        }
+    };
+
+    struct Shard {
+        std::shared_mutex fLock;
+        uint64_t fGeneration = 0;
+        std::unordered_map<ScopeKey, std::unordered_map<std::string, void*>, ScopeKeyHash> fEntries;
+    };
+
+    static const size_t NSHARDS = 16;
+
+    Shard& shard(Kind kind, void* parent, const std::string& name) {
+        size_t h = std::hash<std::string>()(name) ^ std::hash<void*>()(parent) ^ (size_t)kind;
+        return fShards[(h ^ (h >> 17)) % NSHARDS];
+    }
+
+    Shard fShards[NSHARDS];
+};
+
+static LookupCache gLookups;
+
+} // unnamed namespace
+
+// to be called after anything that may have added declarations
+static inline
+void bump_decl_generation(bool user_code = false)
+{
+    gDeclGeneration.fetch_add(1, std::memory_order_acq_rel);
+    if (user_code)
+        gNameGeneration.fetch_add(1, std::memory_order_acq_rel);
+}
+
+// On-demand loading of the standard headers in lazy mode: a miss in std loads the
+// headers that provide the name looked up or, if it is not known to be provided
+// by any of them, all remaining ones. Each load is recorded for reporting.
+namespace {
+
+struct HeaderLoad {
+    std::string fHeader;
+    std::string fTrigger;
+    double      fTime;      // seconds since startup
+};
+
+static std::mutex gLazyHeadersLock;
+static bool gStdHeaderLoaded[N_STD_HEADERS];
+static std::vector<HeaderLoad> gHeaderLoads;
+
+enum LazyLoad { kLoadNamed, kLoadNamedOrAll, kLoadAll };
+
+// loads the pending headers that provide name, or all pending ones, depending on
+// mode; name is then only recorded as the trigger
+static bool load_std_headers(const std::string& name, LazyLoad mode = kLoadNamedOrAll)
+{
+    std::lock_guard<std::mutex> lock(gLazyHeadersLock);
+    if (!gLazyHeadersPending)
+        return false;
+
+    std::vector<size_t> selected;
+    if (mode != kLoadAll) {
+        std::string outer = name.compare(0, 5, "std::") == 0 ? name.substr(5) : name;
+        outer = " " + outer.substr(0, std::min(outer.find('<'), outer.find("::"))) + " ";
+        for (size_t i = 0; i < N_STD_HEADERS; ++i) {
+            if (!gStdHeaderLoaded[i] && strstr(g_std_headers[i].fNames, outer.c_str()))
+                selected.push_back(i);
+        }
+    }
+    if (selected.empty()) {
+        if (mode == kLoadNamed)
+            return false;
+        for (size_t i = 0; i < N_STD_HEADERS; ++i) {
+            if (!gStdHeaderLoaded[i]) selected.push_back(i);
+        }
+    }
+
+    std::string code;
+    for (size_t i : selected)
+        code += std::string("#include ") + g_std_headers[i].fHeader + "\n";
+    Cpp::Process(code.c_str());
+    bump_decl_generation(/*user_code=*/true);
+
+    double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - gStartTime).count();
+    for (size_t i : selected) {
+        gStdHeaderLoaded[i] = true;
+        gHeaderLoads.push_back(HeaderLoad{g_std_headers[i].fHeader, name, t});
+        if (gLazyHeadersVerbose)
+            std::cerr << "cppyy: loaded " << g_std_headers[i].fHeader << " for '" << name
+                      << "' at " << t << "s" << std::endl;
+    }
+
+    if (std::all_of(gStdHeaderLoaded, gStdHeaderLoaded+N_STD_HEADERS, [](bool b) { return b; }))
+        gLazyHeadersPending = false;
+    return true;
+}
+
+// to be called on a failed lookup of name in parent (nullptr for a fully qualified
+// name); returns true if headers were loaded and the lookup is worth repeating
+static inline bool lazy_std_miss(Cppyy::TCppScope_t parent, const std::string& name)
+{
+    if (!gLazyHeadersPending.load(std::memory_order_relaxed))
+        return false;
+    if (parent ? parent != gStdScope : name.compare(0, 5, "std::") != 0)
+        return false;
+    return load_std_headers(name);
+}
+
+// to be called before listing the names in scope
+static inline void lazy_std_names(Cppyy::TCppScope_t scope)
+{
+    if (gLazyHeadersPending.load(std::memory_order_relaxed) && scope == gStdScope)
+        load_std_headers("(names of std)", kLoadAll);
+}
+
+// to be called before compiling code, which may refer to std names not loaded yet
+static void lazy_std_code(const std::string& code)
+{
+    if (!gLazyHeadersPending.load(std::memory_order_relaxed))
+        return;
+    if (code.find("using namespace std") != std::string::npos) {
+        load_std_headers("using namespace std", kLoadAll);
+        return;
+    }
+    for (std::string::size_type pos = code.find("std::"); pos != std::string::npos;
+            pos = code.find("std::", pos+5)) {
+        if (pos && (isalnum((unsigned char)code[pos-1]) || code[pos-1] == '_' || code[pos-1] == ':'))
+            continue;
+        std::string::size_type end = pos+5;
+        while (end < code.size() && (isalnum((unsigned char)code[end]) || code[end] == '_'))
+            ++end;
+        load_std_headers(code.substr(pos, end-pos), kLoadNamed);
+    }
+}
+
+} // unnamed namespace
+
+std::string Cppyy::GetLazyHeaderReport()
+{
+// one line per header loaded on demand: header, the name that triggered the load,
+// and the time (in seconds since startup) at which it was loaded
+    std::lock_guard<std::mutex> lock(gLazyHeadersLock);
+    std::ostringstream report;
+    for (const HeaderLoad& load : gHeaderLoads)
+        report << load.fHeader << '\t' << load.fTrigger << '\t' << load.fTime << '\n';
+    return report.str();
+}
+
+void Cppyy::RecordStartupPhase(const std::string& name, double start, double duration)
+{
+    record_startup_phase(name, start, duration);
+}
+
+std::string Cppyy::GetStartupReport()
+{
+    return startup_report();
+}
+
+void Cppyy::StartInterpreter()
+{
+// Start the initialization deferred by CPPYY_ASYNC_INIT on a background thread
+// and return right away; a no-op otherwise. Not to be called from a static
+// initializer, as the thread needs the loader lock.
+    start_interpreter(/*async=*/true);
+}
+
 // Returns false on failure and true on success
 bool Cppyy::Compile(const std::string& code, bool silent)
 {
+    wait_for_interpreter();
+    lazy_std_code(code);
     // Declare returns an enum which equals 0 on success
-    return !Cpp::Declare(code.c_str(), silent);
+    bool ok = !Cpp::Declare(code.c_str(), silent);
+    bump_decl_generation(/*user_code=*/true);
+    return ok;
 }
 
 std::string Cppyy::ToString(TCppType_t klass, TCppObject_t obj)
@@ -338,6 +760,7 @@ std::string Cppyy::ToString(TCppType_t klass, TCppObject_t obj)
 // // name to opaque C++ scope representation -----------------------------------
 std::string Cppyy::ResolveName(const std::string& cppitem_name)
 {
+    wait_for_interpreter();
 #ifdef PRINT_DEBUG
     printf("Resolve name input = %s\n", cppitem_name.c_str());
 #endif
@@ -438,36 +861,165 @@ bool Cppyy::IsClassType(TCppType_t type) {
     return Cpp::IsRecordType(type);
 }
 
+// Results of the slow type lookups, keyed on the expression string. These go
+// through the interpreter and leave a declaration behind, so each expression is
+// declared only once: successful results are kept for good, failures only until
+// new declarations become available.
+namespace {
+
+class SlowTypeCache {
+public:
+    bool find(const std::string& expr, std::vector<Cpp::TemplateArgInfo>& types, bool& failed) {
+        std::shared_lock<std::shared_mutex> lock(fLock);
+        auto entry = fEntries.find(expr);
+        if (entry == fEntries.end())
+            return false;
+        if (entry->second.fFailed) {
+            if (entry->second.fGeneration != gDeclGeneration.load(std::memory_order_acquire))
+                return false;
+            failed = true;
+            return true;
+        }
+        types.insert(types.end(), entry->second.fTypes.begin(), entry->second.fTypes.end());
+        failed = false;
+        return true;
+    }
+
+    // types is nullptr for a failed lookup
+    void insert(const std::string& expr, const Cpp::TemplateArgInfo* types, size_t ntypes) {
+        std::unique_lock<std::shared_mutex> lock(fLock);
+        Entry& entry = fEntries[expr];
+        entry.fFailed = !types;
+        entry.fGeneration = gDeclGeneration.load(std::memory_order_acquire);
+        entry.fTypes.assign(types, types+(types ? ntypes : 0));
+    }
+
+private:
+    struct Entry {
+        std::vector<Cpp::TemplateArgInfo> fTypes;
+        bool     fFailed = false;
+        uint64_t fGeneration = 0;       // for failures only
+    };
+
+    std::shared_mutex fLock;
+    std::unordered_map<std::string, Entry> fEntries;
+};
+
+static SlowTypeCache gSlowTypes;        // Cppyy::GetType(name, true)
+static SlowTypeCache gSlowTypeLists;    // Cppyy::AppendTypesSlow
+
+static void* lookup_type(const std::string& name)
+{
+    void* type = nullptr;
+    if (!gLookups.find(LookupCache::kType, nullptr, name, type)) {
+        uint64_t generation = gDeclGeneration.load(std::memory_order_acquire);
+        type = Cpp::GetType(name);
+        if (!type && lazy_std_miss(nullptr, name)) {
+            generation = gDeclGeneration.load(std::memory_order_acquire);
+            type = Cpp::GetType(name);
+        }
+        gLookups.insert(LookupCache::kType, nullptr, name, type, generation);
+    }
+    return type;
+}
+
+// name of a fresh variable of the __Cppyy_AppendTypesSlow trampoline type
+static std::string new_type_list_var()
+{
+    static unsigned long long struct_count = 0;
+    if (!struct_count) // initialize the trampoline
+        Cpp::Declare("template<typename ...T> struct __Cppyy_AppendTypesSlow {};\n");
+    return "__s" + std::to_string(struct_count++);
+}
+
+static void collect_type_list(const std::string& var, std::vector<Cpp::TemplateArgInfo>& types)
+{
+    Cppyy::TCppType_t varN = Cpp::GetVariableType(Cpp::GetNamed(var.c_str()));
+    Cppyy::TCppScope_t instance_class = Cpp::GetScopeFromType(varN);
+    Cpp::GetClassTemplateInstantiationArgs(instance_class, types);
+}
+
+} // unnamed namespace
+
 // returns true if no new type was added.
 bool Cppyy::AppendTypesSlow(const std::string &name,
                             std::vector<Cpp::TemplateArgInfo>& types) {
+  bool failed = false;
+  size_t oldSize = types.size();
+  if (gSlowTypeLists.find(name, types, failed))
+    return failed || oldSize == types.size();
+
   // Try going via Cppyy::GetType first.
   if (Cppyy::TCppType_t type = GetType(name, /*enable_slow_lookup=*/true)) {
     types.push_back(type);
+    gSlowTypeLists.insert(name, &types.back(), 1);
     return false;
   }
   // Else, we might have an entire expression such as int, double.
-  static unsigned long long struct_count = 0;
-  std::string code = "template<typename ...T> struct __Cppyy_AppendTypesSlow {};\n";
-  if (!struct_count)
-    Cpp::Declare(code.c_str()); // initialize the trampoline
-
-  std::string var = "__s" + std::to_string(struct_count++);
+  std::string var = new_type_list_var();
   // FIXME: We cannot use silent because it erases our error code from Declare!
-  if (!Cpp::Declare(("__Cppyy_AppendTypesSlow<" + name + "> " + var +";\n").c_str(), /*silent=*/false)) {
-    TCppType_t varN = Cpp::GetVariableType(Cpp::GetNamed(var.c_str()));
-    TCppScope_t instance_class = Cpp::GetScopeFromType(varN);
-    size_t oldSize = types.size();
-    Cpp::GetClassTemplateInstantiationArgs(instance_class, types);
+  failed = Cpp::Declare(("__Cppyy_AppendTypesSlow<" + name + "> " + var +";\n").c_str(), /*silent=*/false);
+  bump_decl_generation();   // may have instantiated templates
+  if (!failed) {
+    collect_type_list(var, types);
+    gSlowTypeLists.insert(name, types.data()+oldSize, types.size()-oldSize);
     return oldSize == types.size();
   }
+  gSlowTypeLists.insert(name, nullptr, 0);
   return true;
 }
 
+// returns true if no new type was added for any of the names.
+bool Cppyy::AppendTypesSlow(const std::vector<std::string>& names,
+                            std::vector<std::vector<Cpp::TemplateArgInfo>>& types) {
+// Resolve all expressions that are neither cached nor simple types in a single
+// declaration; if that fails, fall back to resolving them one by one so that
+// only the offending expressions fail.
+  types.resize(names.size());
+  std::vector<size_t> pending;
+  bool anyFailed = false;
+  for (size_t i = 0; i < names.size(); ++i) {
+    bool failed = false;
+    if (gSlowTypeLists.find(names[i], types[i], failed)) {
+      anyFailed |= failed || types[i].empty();
+    } else if (void* type = lookup_type(names[i])) {
+      types[i].push_back(type);
+      gSlowTypeLists.insert(names[i], &types[i].back(), 1);
+    } else
+      pending.push_back(i);
+  }
+
+  if (pending.size() > 1) {
+    std::vector<std::string> vars;
+    std::string code;
+    for (size_t i : pending) {
+      vars.push_back(new_type_list_var());
+      code += "__Cppyy_AppendTypesSlow<" + names[i] + "> " + vars.back() + ";\n";
+    }
+    bool failed = Cpp::Declare(code.c_str(), /*silent=*/false);
+    bump_decl_generation();
+    if (!failed) {
+      for (size_t j = 0; j < pending.size(); ++j) {
+        std::vector<Cpp::TemplateArgInfo>& result = types[pending[j]];
+        collect_type_list(vars[j], result);
+        gSlowTypeLists.insert(names[pending[j]], result.data(), result.size());
+        anyFailed |= result.empty();
+      }
+      pending.clear();
+    }
+  }
+
+  for (size_t i : pending)
+    anyFailed |= AppendTypesSlow(names[i], types[i]);
+  return anyFailed;
+}
+
 Cppyy::TCppType_t Cppyy::GetType(const std::string &name, bool enable_slow_lookup /* = false */) {
     static unsigned long long var_count = 0;
 
-    if (auto type = Cpp::GetType(name))
+    wait_for_interpreter();
+
+    if (void* type = lookup_type(name))
         return type;
 
     if (!enable_slow_lookup) {
@@ -477,21 +1029,32 @@ Cppyy::TCppType_t Cppyy::GetType(const std::string &name, bool enable_slow_looku
         return nullptr;
     }
 
+    std::vector<Cpp::TemplateArgInfo> cached;
+    bool failed = false;
+    if (gSlowTypes.find(name, cached, failed))
+        return failed ? nullptr : cached.front().m_Type;
+
     // Here we might need to deal with integral types such as 3.14.
 
     std::string id = "__Cppyy_GetType_" + std::to_string(var_count++);
     std::string using_clause = "using " + id + " = __typeof__(" + name + ");\n";
 
-    if (!Cpp::Declare(using_clause.c_str(), /*silent=*/false)) {
+    failed = Cpp::Declare(using_clause.c_str(), /*silent=*/false);
+    bump_decl_generation();
+    if (!failed) {
       TCppScope_t lookup = Cpp::GetNamed(id, 0);
       TCppType_t lookup_ty = Cpp::GetTypeFromScope(lookup);
-      return Cpp::GetCanonicalType(lookup_ty);
+      Cpp::TemplateArgInfo result(Cpp::GetCanonicalType(lookup_ty));
+      gSlowTypes.insert(name, &result, 1);
+      return result.m_Type;
     }
+    gSlowTypes.insert(name, nullptr, 0);
     return nullptr;
 }
 
 
 Cppyy::TCppType_t Cppyy::GetComplexType(const std::string &name) {
+    wait_for_interpreter();
     return Cpp::GetComplexType(Cpp::GetType(name));
 }
 
@@ -540,18 +1103,40 @@ Cppyy::TCppScope_t Cppyy::GetUnderlyingScope(TCppScope_t scope)
 Cppyy::TCppScope_t Cppyy::GetScope(const std::string& name,
                                    TCppScope_t parent_scope)
 {
+    wait_for_interpreter();
 #ifndef NDEBUG
     if (name.find("::") != std::string::npos)
         throw std::runtime_error("Calling Cppyy::GetScope with qualified name '"
                                  + name + "'\n");
 #endif // NDEBUG
 
-    return Cpp::GetScope(name, parent_scope);
+    void* scope = nullptr;
+    if (!gLookups.find(LookupCache::kScope, parent_scope, name, scope)) {
+        uint64_t generation = gDeclGeneration.load(std::memory_order_acquire);
+        scope = Cpp::GetScope(name, parent_scope);
+        if (!scope && lazy_std_miss(parent_scope, name)) {
+            generation = gDeclGeneration.load(std::memory_order_acquire);
+            scope = Cpp::GetScope(name, parent_scope);
+        }
+        gLookups.insert(LookupCache::kScope, parent_scope, name, scope, generation);
+    }
+    return scope;
 }
 
 Cppyy::TCppScope_t Cppyy::GetFullScope(const std::string& name)
 {
-    return Cpp::GetScopeFromCompleteName(name);
+    wait_for_interpreter();
+    void* scope = nullptr;
+    if (!gLookups.find(LookupCache::kFullScope, nullptr, name, scope)) {
+        uint64_t generation = gDeclGeneration.load(std::memory_order_acquire);
+        scope = Cpp::GetScopeFromCompleteName(name);
+        if (!scope && lazy_std_miss(nullptr, name)) {
+            generation = gDeclGeneration.load(std::memory_order_acquire);
+            scope = Cpp::GetScopeFromCompleteName(name);
+        }
+        gLookups.insert(LookupCache::kFullScope, nullptr, name, scope, generation);
+    }
+    return scope;
 }
 
 Cppyy::TCppScope_t Cppyy::GetTypeScope(TCppScope_t var)
@@ -563,7 +1148,18 @@ Cppyy::TCppScope_t Cppyy::GetTypeScope(TCppScope_t var)
 Cppyy::TCppScope_t Cppyy::GetNamed(const std::string& name,
                                    TCppScope_t parent_scope)
 {
-    return Cpp::GetNamed(name, parent_scope);
+    wait_for_interpreter();
+    void* named = nullptr;
+    if (!gLookups.find(LookupCache::kNamed, parent_scope, name, named)) {
+        uint64_t generation = gDeclGeneration.load(std::memory_order_acquire);
+        named = Cpp::GetNamed(name, parent_scope);
+        if (!named && lazy_std_miss(parent_scope, name)) {
+            generation = gDeclGeneration.load(std::memory_order_acquire);
+            named = Cpp::GetNamed(name, parent_scope);
+        }
+        gLookups.insert(LookupCache::kNamed, parent_scope, name, named, generation);
+    }
+    return named;
 }
 
 Cppyy::TCppScope_t Cppyy::GetParentScope(TCppScope_t scope)
@@ -583,6 +1179,7 @@ Cppyy::TCppType_t Cppyy::GetTypeFromScope(TCppScope_t klass)
 
 Cppyy::TCppScope_t Cppyy::GetGlobalScope()
 {
+    wait_for_interpreter();
     return Cpp::GetGlobalScope();
 }
 
@@ -666,6 +1263,99 @@ bool Cppyy::IsTypedefed(TCppScope_t handle)
 //     return klass;
 // }
 
+// Dynamic type resolution: the most-derived class of a polymorphic object follows
+// from the std::type_info that the Itanium ABI places right before the address
+// point of the vtable. The mapping of type_info to scope, as well as whether a
+// class is polymorphic at all, is cached, so that after the first object of a
+// given dynamic type, resolution is a hash lookup under a shared lock.
+namespace {
+
+class ActualClassCache {
+public:
+    bool is_polymorphic(Cppyy::TCppScope_t klass) {
+        {
+            std::shared_lock<std::shared_mutex> lock(fLock);
+            auto it = fPolymorphic.find(klass);
+            if (it != fPolymorphic.end())
+                return it->second;
+        }
+
+        bool poly = has_virtuals(klass);
+        std::unique_lock<std::shared_mutex> lock(fLock);
+        fPolymorphic[klass] = poly;
+        return poly;
+    }
+
+    Cppyy::TCppScope_t scope_of(const std::type_info* ti) {
+        uint64_t generation = gDeclGeneration.load(std::memory_order_acquire);
+        {
+            std::shared_lock<std::shared_mutex> lock(fLock);
+            auto it = fTypes.find(ti);
+            if (it != fTypes.end() && (it->second.fScope || it->second.fGeneration == generation))
+                return it->second.fScope;
+        }
+
+        Cppyy::TCppScope_t scope = nullptr;
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(ti->name(), nullptr, nullptr, &status);
+        if (status == 0 && demangled) {
+            scope = Cppyy::GetFullScope(demangled);
+            if (scope && !Cpp::IsClass(scope))
+                scope = nullptr;
+        }
+        free(demangled);
+
+        std::unique_lock<std::shared_mutex> lock(fLock);
+        fTypes[ti] = Entry{scope, generation};
+        return scope;
+    }
+
+private:
+    static bool has_virtuals(Cppyy::TCppScope_t klass) {
+        if (!Cpp::IsClass(klass) || !Cpp::IsComplete(klass))
+            return false;
+        Cppyy::MethodSpan methods;
+        if (Cppyy::GetClassMethodsSpan(klass, methods)) {
+            for (Cppyy::TCppMethod_t m : methods) {
+                if (Cpp::IsVirtualMethod(m))
+                    return true;
+            }
+        }
+        for (Cppyy::TCppIndex_t ibase = 0; ibase < Cppyy::GetNumBases(klass); ++ibase) {
+            if (has_virtuals(Cppyy::GetBaseScope(klass, ibase)))
+                return true;
+        }
+        return false;
+    }
+
+    struct Entry {
+        Cppyy::TCppScope_t fScope;
+        uint64_t           fGeneration;     // for failures only
+    };
+
+    std::shared_mutex fLock;
+    std::unordered_map<Cppyy::TCppScope_t, bool> fPolymorphic;
+    std::unordered_map<const std::type_info*, Entry> fTypes;
+};
+
+static ActualClassCache gActualClasses;
+
+} // unnamed namespace
+
+Cppyy::TCppType_t Cppyy::GetActualClass(TCppType_t klass, TCppObject_t obj)
+{
+    if (!klass || !obj || !gActualClasses.is_polymorphic(klass))
+        return klass;   // not polymorphic: no RTTI info available
+
+    void** vptr = *(void***)obj;
+    const std::type_info* ti = (const std::type_info*)vptr[-1];
+    if (!ti)
+        return klass;
+
+    TCppScope_t actual = gActualClasses.scope_of(ti);
+    return actual ? actual : klass;
+}
+
 size_t Cppyy::SizeOf(TCppScope_t klass)
 {
     return Cpp::SizeOf(klass);
@@ -710,6 +1400,135 @@ bool Cppyy::IsComplete(TCppScope_t scope)
     return Cpp::IsComplete(scope);
 }
 
+// object pools --------------------------------------------------------------
+// By-value results and constructed objects are drawn from per-thread free lists,
+// one per object size. Each block is an individual ::operator new of exactly the
+// object's size, so pooled objects can still be freed the normal way, including
+// through a sized delete.
+namespace {
+
+const size_t POOL_MAX_SIZE = 512;
+const size_t POOL_MAX_FREE = 256;       // per size and thread
+
+struct PoolStats {
+    std::atomic<size_t> fAllocs{0};     // total allocations
+    std::atomic<size_t> fReuses{0};     // allocations served from a free list
+    std::atomic<size_t> fReleases{0};   // total releases
+    std::atomic<size_t> fCached{0};     // blocks currently held on free lists
+};
+static PoolStats gPoolStats;
+
+class ObjectPool {
+    struct FreeBlock { FreeBlock* fNext; };
+
+public:
+    ObjectPool() {
+        for (size_t i = 0; i <= POOL_MAX_SIZE; ++i) { fFree[i] = nullptr; fCount[i] = 0; }
+    }
+    ~ObjectPool() {
+        for (size_t i = 0; i <= POOL_MAX_SIZE; ++i) {
+            while (FreeBlock* b = fFree[i]) {
+                fFree[i] = b->fNext;
+                ::operator delete((void*)b);
+            }
+            gPoolStats.fCached.fetch_sub(fCount[i], std::memory_order_relaxed);
+        }
+    }
+
+    void* allocate(size_t size) {
+        gPoolStats.fAllocs.fetch_add(1, std::memory_order_relaxed);
+        if (!poolable(size))
+            return ::operator new(size ? size : 1);
+        if (FreeBlock* b = fFree[size]) {
+            fFree[size] = b->fNext;
+            fCount[size] -= 1;
+            gPoolStats.fReuses.fetch_add(1, std::memory_order_relaxed);
+            gPoolStats.fCached.fetch_sub(1, std::memory_order_relaxed);
+            return (void*)b;
+        }
+        return ::operator new(size);
+    }
+
+    void release(void* mem, size_t size) {
+        if (!mem) return;
+        gPoolStats.fReleases.fetch_add(1, std::memory_order_relaxed);
+        if (!poolable(size) || fCount[size] == POOL_MAX_FREE) {
+            ::operator delete(mem);
+            return;
+        }
+        FreeBlock* b = (FreeBlock*)mem;
+        b->fNext = fFree[size];
+        fFree[size] = b;
+        fCount[size] += 1;
+        gPoolStats.fCached.fetch_add(1, std::memory_order_relaxed);
+    }
+
+private:
+    static bool poolable(size_t size) {
+        return sizeof(FreeBlock) <= size && size <= POOL_MAX_SIZE;
+    }
+
+    FreeBlock* fFree[POOL_MAX_SIZE+1];
+    size_t     fCount[POOL_MAX_SIZE+1];
+};
+
+static thread_local ObjectPool tPool;
+
+// sizes are cached per thread, to keep reflection queries off the call path, and
+// dropped when new declarations become visible; classes with their own operator
+// new are not pooled, as their matching delete would otherwise receive memory it
+// did not hand out
+struct PoolScope { size_t fSize; bool fPooled; };
+static thread_local std::unordered_map<Cppyy::TCppType_t, PoolScope> tTypeSizes;
+static thread_local std::unordered_map<Cppyy::TCppScope_t, PoolScope> tScopeSizes;
+static thread_local uint64_t tPoolSizesGeneration = 0;
+
+static inline
+void check_pool_sizes_generation()
+{
+    uint64_t generation = gDeclGeneration.load(std::memory_order_acquire);
+    if (tPoolSizesGeneration != generation) {
+        tTypeSizes.clear();
+        tScopeSizes.clear();
+        tPoolSizesGeneration = generation;
+    }
+}
+
+static inline
+const PoolScope& pool_scope(Cppyy::TCppScope_t scope);
+
+static inline
+PoolScope pool_type(Cppyy::TCppType_t type)
+{
+    check_pool_sizes_generation();
+    auto it = tTypeSizes.find(type);
+    if (it != tTypeSizes.end())
+        return it->second;
+    PoolScope ps;
+    ps.fSize   = Cpp::GetSizeOfType(type);
+    ps.fPooled = true;
+    Cppyy::TCppScope_t scope = Cpp::GetScopeFromType(type);
+    if (scope && Cpp::IsClass(scope))
+        ps.fPooled = pool_scope(scope).fPooled;
+    tTypeSizes.emplace(type, ps);
+    return ps;
+}
+
+static inline
+const PoolScope& pool_scope(Cppyy::TCppScope_t scope)
+{
+    check_pool_sizes_generation();
+    auto it = tScopeSizes.find(scope);
+    if (it != tScopeSizes.end())
+        return it->second;
+    PoolScope ps;
+    ps.fSize   = Cpp::SizeOf(scope);
+    ps.fPooled = ps.fSize && Cpp::GetFunctionsUsingName(scope, "operator new").empty();
+    return tScopeSizes.emplace(scope, ps).first->second;
+}
+
+} // unnamed namespace
+
 // // memory management ---------------------------------------------------------
 Cppyy::TCppObject_t Cppyy::Allocate(TCppScope_t scope)
 {
@@ -723,42 +1542,222 @@ void Cppyy::Deallocate(TCppScope_t scope, TCppObject_t instance)
 
 Cppyy::TCppObject_t Cppyy::Construct(TCppScope_t scope, void* arena/*=nullptr*/)
 {
-    return Cpp::Construct(scope, arena);
+    if (arena)
+        return Cpp::Construct(scope, arena);
+
+    PoolScope ps = pool_scope(scope);
+    if (!ps.fPooled)
+        return Cpp::Construct(scope, nullptr);
+
+    void* mem = tPool.allocate(ps.fSize);
+    TCppObject_t obj = Cpp::Construct(scope, mem);
+    if (!obj) tPool.release(mem, ps.fSize);
+    return obj;
 }
 
-void Cppyy::Destruct(TCppScope_t scope, TCppObject_t instance)
+void Cppyy::ReleaseObject(TCppScope_t scope, TCppObject_t instance)
 {
-    Cpp::Destruct(instance, scope);
+// Return the memory of an object obtained from Construct, CallConstructor, or
+// CallO, and already destructed, to the pool. Objects of classes with their own
+// operator new never come from the pool and must be freed through Destruct (or,
+// for results of CallO, Deallocate) instead; they are left alone here.
+    PoolScope ps = pool_scope(scope);
+    if (!ps.fPooled)
+        return;
+    tPool.release(instance, ps.fSize);
 }
 
-static inline
-bool copy_args(Parameter* args, size_t nargs, void** vargs)
+void Cppyy::GetObjectPoolStats(
+    size_t* allocs, size_t* reuses, size_t* releases, size_t* cached)
 {
-    bool runRelease = false;
-    for (size_t i = 0; i < nargs; ++i) {
-        switch (args[i].fTypeCode) {
-        case 'X':       /* (void*)type& with free */
-            runRelease = true;
-        case 'V':       /* (void*)type& */
-            vargs[i] = args[i].fValue.fVoidp;
-            break;
-        case 'r':       /* const type& */
-            vargs[i] = args[i].fRef;
-            break;
-        default:        /* all other types in union */
-            vargs[i] = (void*)&args[i].fValue.fVoidp;
-            break;
-        }
-    }
-    return runRelease;
+    if (allocs)   *allocs   = gPoolStats.fAllocs.load(std::memory_order_relaxed);
+    if (reuses)   *reuses   = gPoolStats.fReuses.load(std::memory_order_relaxed);
+    if (releases) *releases = gPoolStats.fReleases.load(std::memory_order_relaxed);
+    if (cached)   *cached   = gPoolStats.fCached.load(std::memory_order_relaxed);
 }
 
-static inline
-void release_args(Parameter* args, size_t nargs) {
+void Cppyy::Destruct(TCppScope_t scope, TCppObject_t instance)
+{
+    Cpp::Destruct(instance, scope);
+}
+
+// scratch arena -------------------------------------------------------------
+// Per-thread bump storage for by-reference temporaries created by converters.
+// Such arguments are passed with type code 'T' (like 'V', the address is in the
+// value) and, after the call, the arena is rewound in one step to the lowest
+// temporary of that call. Calls made while converting the arguments of another
+// call only allocate above that call's earlier temporaries and rewind before
+// its later ones are created, so nesting is safe.
+namespace {
+
+const size_t SCRATCH_ALIGN      = 16;
+const size_t SCRATCH_CHUNK_SIZE = 4096;
+
+class ScratchArena {
+    struct Chunk {
+        Chunk* fPrev;
+        size_t fSize;                   // usable bytes following the header
+        size_t fUsed;
+        char*  data() { return (char*)this + HDR; }
+    };
+    static const size_t HDR = (sizeof(Chunk) + SCRATCH_ALIGN - 1) & ~(SCRATCH_ALIGN - 1);
+
+public:
+    ~ScratchArena() {
+        while (fChunk) { Chunk* c = fChunk; fChunk = c->fPrev; ::operator delete((void*)c); }
+        if (fSpare) ::operator delete((void*)fSpare);
+    }
+
+    void* allocate(size_t size) {
+        size = (size + SCRATCH_ALIGN - 1) & ~(SCRATCH_ALIGN - 1);
+        if (!size) size = SCRATCH_ALIGN;
+        if (!fChunk || fChunk->fSize - fChunk->fUsed < size) {
+            Chunk* c = nullptr;
+            if (fSpare && size <= fSpare->fSize) {
+                c = fSpare;
+                fSpare = nullptr;
+            } else {
+                size_t csz = size < SCRATCH_CHUNK_SIZE ? SCRATCH_CHUNK_SIZE : size;
+                c = (Chunk*)::operator new(HDR + csz);
+                c->fSize = csz;
+            }
+            c->fPrev = fChunk;
+            c->fUsed = 0;
+            fChunk = c;
+        }
+        void* mem = fChunk->data() + fChunk->fUsed;
+        fChunk->fUsed += size;
+        return mem;
+    }
+
+    // release mem and everything allocated after it; ignores foreign pointers
+    void rewind(void* mem) {
+        Chunk* owner = fChunk;
+        while (owner && !owns(owner, mem))
+            owner = owner->fPrev;
+        if (!owner) return;
+        while (fChunk != owner) pop_chunk();
+        fChunk->fUsed = (char*)mem - fChunk->data();
+    }
+
+    // of two allocations (either may be null), the one made first, i.e. the one
+    // to rewind to for releasing both; chunks are not ordered in memory, so the
+    // addresses are only comparable within a chunk
+    void* earliest(void* a, void* b) {
+        if (!a || !b) return a ? a : b;
+        for (Chunk* c = fChunk; c; c = c->fPrev) {
+            bool has_a = owns(c, a), has_b = owns(c, b);
+            if (has_a && has_b) return a < b ? a : b;
+            if (has_a) return b;
+            if (has_b) return a;
+        }
+        return a;
+    }
+
+    void reset() {
+        while (fChunk && fChunk->fPrev) pop_chunk();
+        if (fChunk) fChunk->fUsed = 0;
+    }
+
+private:
+    static bool owns(Chunk* c, void* mem) {
+        return (char*)mem >= c->data() && (char*)mem < c->data() + c->fUsed;
+    }
+
+    void pop_chunk() {
+        Chunk* c = fChunk;
+        fChunk = c->fPrev;
+        if (fSpare && c->fSize <= fSpare->fSize)
+            ::operator delete((void*)c);
+        else {
+            if (fSpare) ::operator delete((void*)fSpare);
+            fSpare = c;
+        }
+    }
+
+    Chunk* fChunk = nullptr;
+    Chunk* fSpare = nullptr;
+};
+
+static thread_local ScratchArena tScratch;
+
+} // unnamed namespace
+
+static inline
+bool copy_args(Parameter* args, size_t nargs, void** vargs)
+{
+    bool runRelease = false;
+    for (size_t i = 0; i < nargs; ++i) {
+        switch (args[i].fTypeCode) {
+        case 'X':       /* (void*)type& with free */
+        case 'T':       /* (void*)type& in scratch arena */
+            runRelease = true;
+        case 'V':       /* (void*)type& */
+            vargs[i] = args[i].fValue.fVoidp;
+            break;
+        case 'r':       /* const type& */
+            vargs[i] = args[i].fRef;
+            break;
+        default:        /* all other types in union */
+            vargs[i] = (void*)&args[i].fValue.fVoidp;
+            break;
+        }
+    }
+    return runRelease;
+}
+
+// frees the 'X' arguments and returns the earliest 'T' one, for the caller to
+// rewind the scratch arena to
+static inline
+void* release_args(Parameter* args, size_t nargs) {
+    void* scratch = nullptr;
     for (size_t i = 0; i < nargs; ++i) {
         if (args[i].fTypeCode == 'X')
             free(args[i].fValue.fVoidp);
+        else if (args[i].fTypeCode == 'T')
+            scratch = tScratch.earliest(scratch, args[i].fValue.fVoidp);
+    }
+    return scratch;
+}
+
+// packed frames: nargs 8-byte value slots, followed by nargs type codes; the
+// codes are those of Parameter, with 'X', 'T', 'V', and 'r' carrying the address
+// in the slot (values that do not fit a slot, e.g. long double, are passed as 'V')
+static inline
+bool copy_args_packed(void* args, size_t nargs, void** vargs)
+{
+    uint64_t* slots = (uint64_t*)args;
+    const char* codes = (const char*)(slots + nargs);
+    bool runRelease = false;
+    for (size_t i = 0; i < nargs; ++i) {
+        switch (codes[i]) {
+        case 'X':       /* (void*)type& with free */
+        case 'T':       /* (void*)type& in scratch arena */
+            runRelease = true;
+        case 'V':       /* (void*)type& */
+        case 'r':       /* const type& */
+            vargs[i] = (void*)(uintptr_t)slots[i];
+            break;
+        default:        /* value stored at the start of the slot */
+            vargs[i] = (void*)&slots[i];
+            break;
+        }
+    }
+    return runRelease;
+}
+
+static inline
+void* release_args_packed(void* args, size_t nargs) {
+    uint64_t* slots = (uint64_t*)args;
+    const char* codes = (const char*)(slots + nargs);
+    void* scratch = nullptr;
+    for (size_t i = 0; i < nargs; ++i) {
+        if (codes[i] == 'X')
+            free((void*)(uintptr_t)slots[i]);
+        else if (codes[i] == 'T')
+            scratch = tScratch.earliest(scratch, (void*)(uintptr_t)slots[i]);
     }
+    return scratch;
 }
 
 // static inline
@@ -766,39 +1765,641 @@ void release_args(Parameter* args, size_t nargs) {
 //     return (!is_direct && wrap->fFaceptr.fGeneric) || (is_direct && wrap->fFaceptr.fDirect);
 // }
 
+// Direct calls through the function address, bypassing both the argument
+// boxing and the generic wrapper. Supported are signatures with only builtin,
+// pointer, and reference arguments and a void, builtin, pointer, or reference
+// result. Integer-class and floating point arguments are passed in separate
+// register banks on the ABIs below, so a single trampoline per result class,
+// which fills all argument registers, serves every supported signature.
+#if ((defined(__x86_64__) && !defined(_WIN32)) || defined(__aarch64__)) && \
+        __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define CPPYY_FASTPATH_ABI 1
+#endif
+
+namespace {
+
+const int FASTPATH_INT_REGS = 6;
+const int FASTPATH_FP_REGS  = 8;
+typedef intptr_t I_t;
+
+struct FastPath {
+    void*   fAddress;               // null if not eligible
+    size_t  fNArgs;
+    bool    fHasSelf;
+    char    fRetKind;               // 'v'oid, 'i'nteger class, 'f'loat, 'd'ouble
+    uint8_t fRetSize;
+    char    fArgKinds[SMALL_ARGS_N];
+};
+
+#ifdef CPPYY_FASTPATH_ABI
+template<typename R>
+using Trampoline_t = R (*)(I_t, I_t, I_t, I_t, I_t, I_t,
+    double, double, double, double, double, double, double, double);
+
+template<typename R>
+static inline R fast_invoke(void* address, const I_t* i, const double* d)
+{
+    return ((Trampoline_t<R>)address)(
+        i[0], i[1], i[2], i[3], i[4], i[5], d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7]);
+}
+#endif
+
+// argument/result classification: 'a'ddress (references), 'b'ool, 'c'har, 'C'
+// unsigned char, 'h' short, 'H' unsigned short, 'i' int, 'I' unsigned int, 'l'
+// 64b integers and pointers, 'f'loat, 'd'ouble; or 0 if not supported
+static char fastpath_kind(Cppyy::TCppType_t type)
+{
+    static const std::map<std::string, char> s_kinds = {
+        {"bool", 'b'}, {"char", (char)-1 < 0 ? 'c' : 'C'}, {"signed char", 'c'},
+        {"unsigned char", 'C'}, {"short", 'h'}, {"unsigned short", 'H'},
+        {"char16_t", 'H'}, {"int", 'i'}, {"unsigned int", 'I'}, {"wchar_t", 'i'},
+        {"char32_t", 'I'}, {"long", 'l'}, {"unsigned long", 'l'}, {"long long", 'l'},
+        {"unsigned long long", 'l'}, {"float", 'f'}, {"double", 'd'}};
+
+    if (!type) return (char)0;
+    std::string name = Cpp::GetTypeAsString(Cppyy::ResolveType(type));
+    if (name.compare(0, 6, "const ") == 0)
+        name = name.substr(6);
+    if (6 < name.size() && name.compare(name.size()-6, 6, " const") == 0)
+        name = name.substr(0, name.size()-6);
+
+    if (name.empty())
+        return (char)0;
+    if (name.back() == '&')
+        return 'a';
+    if (name.back() == '*')
+        return sizeof(void*) == sizeof(I_t) ? 'l' : (char)0;
+
+    auto kind = s_kinds.find(name);
+    return kind != s_kinds.end() ? kind->second : (char)0;
+}
+
+static FastPath make_fastpath(Cppyy::TCppMethod_t method)
+{
+    FastPath fp{};
+#ifdef CPPYY_FASTPATH_ABI
+    if (Cpp::IsConstructor(method) || Cpp::IsDestructor(method) || Cpp::IsVirtualMethod(method))
+        return fp;
+
+    fp.fNArgs = Cpp::GetFunctionNumArgs(method);
+    if (SMALL_ARGS_N < fp.fNArgs)
+        return fp;
+
+    fp.fHasSelf = !Cpp::IsStaticMethod(method) && Cpp::IsClass(Cpp::GetParentScope(method));
+    int nint = fp.fHasSelf ? 1 : 0, nfp = 0;
+    for (size_t i = 0; i < fp.fNArgs; ++i) {
+        char kind = fastpath_kind(Cpp::GetFunctionArgType(method, i));
+        if (!kind) return fp;
+        (kind == 'f' || kind == 'd') ? ++nfp : ++nint;
+        fp.fArgKinds[i] = kind;
+    }
+    if (FASTPATH_INT_REGS < nint || FASTPATH_FP_REGS < nfp)
+        return fp;
+
+    Cppyy::TCppType_t rtype = Cpp::GetFunctionReturnType(method);
+    if (Cpp::GetTypeAsString(Cpp::GetCanonicalType(rtype)) == "void") {
+        fp.fRetKind = 'v';
+    } else {
+        char kind = fastpath_kind(rtype);
+        switch (kind) {
+        case 0:
+            return fp;
+        case 'f':
+        case 'd':
+            fp.fRetKind = kind;
+            break;
+        case 'a':
+            fp.fRetKind = 'i';
+            fp.fRetSize = sizeof(void*);
+            break;
+        default:
+            fp.fRetKind = 'i';
+            fp.fRetSize = (uint8_t)Cpp::GetSizeOfType(Cppyy::ResolveType(rtype));
+            if (!fp.fRetSize || sizeof(I_t) < fp.fRetSize)
+                return fp;
+            break;
+        }
+    }
+
+    fp.fAddress = (void*)Cppyy::GetFunctionAddress(method);
+#endif
+    return fp;
+}
+
+#ifdef CPPYY_FASTPATH_ABI
+static inline
+void fast_call(const FastPath& fp, void** vargs, void* self, void* result)
+{
+    I_t    iregs[FASTPATH_INT_REGS] = {0};
+    double fregs[FASTPATH_FP_REGS]  = {0.};
+    int ni = 0, nf = 0;
+
+    if (fp.fHasSelf) iregs[ni++] = (I_t)self;
+    for (size_t i = 0; i < fp.fNArgs; ++i) {
+        void* addr = vargs[i];
+        switch (fp.fArgKinds[i]) {
+        case 'a': iregs[ni++] = (I_t)addr;                   break;
+        case 'b': iregs[ni++] = (I_t)*(bool*)addr;           break;
+        case 'c': iregs[ni++] = (I_t)*(int8_t*)addr;         break;
+        case 'C': iregs[ni++] = (I_t)*(uint8_t*)addr;        break;
+        case 'h': iregs[ni++] = (I_t)*(short*)addr;          break;
+        case 'H': iregs[ni++] = (I_t)*(unsigned short*)addr; break;
+        case 'i': iregs[ni++] = (I_t)*(int*)addr;            break;
+        case 'I': iregs[ni++] = (I_t)*(unsigned int*)addr;   break;
+        case 'l': iregs[ni++] = *(I_t*)addr;                 break;
+        case 'd': fregs[nf++] = *(double*)addr;              break;
+        case 'f':       /* float in the low bits of the register */
+            memcpy((void*)&fregs[nf++], addr, sizeof(float));
+            break;
+        }
+    }
+
+    switch (fp.fRetKind) {
+    case 'v':
+        fast_invoke<void>(fp.fAddress, iregs, fregs);
+        break;
+    case 'i': {
+        I_t r = fast_invoke<I_t>(fp.fAddress, iregs, fregs);
+        if (result) memcpy(result, &r, fp.fRetSize);
+        break;
+    }
+    case 'f': {
+        float r = fast_invoke<float>(fp.fAddress, iregs, fregs);
+        if (result) *(float*)result = r;
+        break;
+    }
+    case 'd': {
+        double r = fast_invoke<double>(fp.fAddress, iregs, fregs);
+        if (result) *(double*)result = r;
+        break;
+    }
+    }
+}
+#endif
+
+// Memoized callables, keyed on the method decl. Lookups are lock-free: the
+// table is open addressed (linear probing, at most half full) and entries are
+// immutable once published. Creation of new entries, which may require JIT-ing
+// a wrapper, is serialized. Replaced tables and invalidated entries are kept
+// alive until shutdown, as concurrent callers may still be using them.
+class CallableCache {
+public:
+    struct Entry {
+        Entry(Cppyy::TCppMethod_t method, const Cpp::JitCall& jc, const FastPath& fp) :
+            fMethod(method), fJC(jc), fFast(fp) {}
+        Cppyy::TCppMethod_t fMethod;
+        Cpp::JitCall        fJC;
+        FastPath            fFast;
+    };
+
+public:
+    CallableCache() : fTable(new_table(64)) {}
+    ~CallableCache() {
+        for (auto e : fEntries) delete e;
+        for (auto t : fRetired) delete_table(t);
+        delete_table(fTable.load());
+    }
+
+    Entry* get(Cppyy::TCppMethod_t method) {
+        if (Entry* e = find(fTable.load(std::memory_order_acquire), method))
+            return e;
+        return insert(method);
+    }
+
+    void invalidate(Cppyy::TCppMethod_t method) {
+        std::lock_guard<std::mutex> lock(fMutex);
+        Table* old = fTable.load(std::memory_order_relaxed);
+        Table* t = new_table(old->fMask+1);
+        if (method) {
+            for (size_t i = 0; i <= old->fMask; ++i) {
+                Entry* e = old->fSlots[i].load(std::memory_order_relaxed);
+                if (e && e->fMethod != method) place(t, e);
+            }
+        }
+        fTable.store(t, std::memory_order_release);
+        fRetired.push_back(old);
+    }
+
+private:
+    struct Table {
+        size_t fMask;
+        size_t fUsed;
+        std::atomic<Entry*>* fSlots;
+    };
+
+    static Table* new_table(size_t size) {
+        return new Table{size-1, 0, new std::atomic<Entry*>[size]()};
+    }
+
+    static void delete_table(Table* t) {
+        delete [] t->fSlots;
+        delete t;
+    }
+
+    static size_t hash(Cppyy::TCppMethod_t method) {
+        uint64_t h = (uint64_t)(uintptr_t)method;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return (size_t)h;
+    }
+
+    static Entry* find(Table* t, Cppyy::TCppMethod_t method) {
+        for (size_t i = hash(method) & t->fMask;; i = (i+1) & t->fMask) {
+            Entry* e = t->fSlots[i].load(std::memory_order_acquire);
+            if (!e || e->fMethod == method)
+                return e;
+        }
+    }
+
+    static void place(Table* t, Entry* e) {
+        size_t i = hash(e->fMethod) & t->fMask;
+        while (t->fSlots[i].load(std::memory_order_relaxed))
+            i = (i+1) & t->fMask;
+        t->fSlots[i].store(e, std::memory_order_release);
+        t->fUsed += 1;
+    }
+
+    Entry* insert(Cppyy::TCppMethod_t method) {
+        assert_interpreter_ready();
+        std::lock_guard<std::mutex> lock(fMutex);
+        Table* t = fTable.load(std::memory_order_relaxed);
+        if (Entry* e = find(t, method))
+            return e;       // created by another thread in the meantime
+
+        Cpp::JitCall JC = Cpp::MakeFunctionCallable(method);
+        if (!JC)
+            return nullptr; // not memoized: happens with compilation errors
+
+        FastPath fp{};
+        if (gEnableFastPath) fp = make_fastpath(method);
+
+        Entry* e = new Entry(method, JC, fp);
+        fEntries.push_back(e);
+
+        if (2*(t->fUsed+1) > t->fMask+1) {
+            Table* bigger = new_table(2*(t->fMask+1));
+            for (size_t i = 0; i <= t->fMask; ++i) {
+                if (Entry* old = t->fSlots[i].load(std::memory_order_relaxed))
+                    place(bigger, old);
+            }
+            place(bigger, e);
+            fTable.store(bigger, std::memory_order_release);
+            fRetired.push_back(t);
+        } else
+            place(t, e);
+
+        return e;
+    }
+
+private:
+    std::atomic<Table*> fTable;
+    std::mutex          fMutex;
+    std::vector<Entry*> fEntries;
+    std::vector<Table*> fRetired;
+};
+
+static CallableCache gCallables;
+
+} // unnamed namespace
+
+// argument frames -----------------------------------------------------------
+// Argument buffers are carved from a per-thread slab in LIFO order. Frames that
+// are released out of order (or from another thread) are only marked and get
+// reclaimed once everything above them is released as well. Frames must be
+// released before their allocating thread exits.
+namespace {
+
+const size_t SLAB_ALIGN      = 16;      // enough for long double in Parameter
+const size_t SLAB_CHUNK_SIZE = 16384;
+
+static inline
+size_t slab_align(size_t sz) { return (sz + SLAB_ALIGN - 1) & ~(SLAB_ALIGN - 1); }
+
+class ArgSlab {
+    struct Chunk {
+        Chunk* fPrev;
+        size_t fSize;                   // usable bytes following the header
+        size_t fUsed;
+    };
+
+    struct Frame {
+        Frame*            fPrev;
+        Chunk*            fChunk;
+        size_t            fMark;        // fUsed of fChunk before this frame
+        ArgSlab*          fOwner;
+        std::atomic<bool> fFreed;
+    };
+
+    static const size_t CHUNK_HDR;
+    static const size_t FRAME_HDR;
+
+public:
+    ~ArgSlab() {
+        while (fChunk) { Chunk* c = fChunk; fChunk = c->fPrev; ::operator delete((void*)c); }
+        if (fSpare) ::operator delete((void*)fSpare);
+    }
+
+    void* allocate(size_t bytes) {
+        size_t need = FRAME_HDR + slab_align(bytes ? bytes : 1);
+        if (!fChunk || fChunk->fSize - fChunk->fUsed < need)
+            push_chunk(need);
+        Frame* f = (Frame*)((char*)fChunk + CHUNK_HDR + fChunk->fUsed);
+        f->fPrev  = fTop;
+        f->fChunk = fChunk;
+        f->fMark  = fChunk->fUsed;
+        f->fOwner = this;
+        new (&f->fFreed) std::atomic<bool>(false);
+        fChunk->fUsed += need;
+        fTop = f;
+        return (char*)f + FRAME_HDR;
+    }
+
+    void deallocate(void* mem) {
+        if (!mem) return;
+        Frame* f = (Frame*)((char*)mem - FRAME_HDR);
+        if (f->fOwner != this) {
+            f->fFreed.store(true, std::memory_order_release);
+            return;
+        }
+        f->fFreed.store(true, std::memory_order_relaxed);
+        while (fTop && fTop->fFreed.load(std::memory_order_acquire)) {
+            Frame* top = fTop;
+            fTop = top->fPrev;
+            while (fChunk != top->fChunk) pop_chunk();
+            fChunk->fUsed = top->fMark;
+        }
+    }
+
+private:
+    void push_chunk(size_t need) {
+        Chunk* c = nullptr;
+        if (fSpare && need <= fSpare->fSize) {
+            c = fSpare;
+            fSpare = nullptr;
+        } else {
+            size_t size = need < SLAB_CHUNK_SIZE ? SLAB_CHUNK_SIZE : need;
+            c = (Chunk*)::operator new(CHUNK_HDR + size);
+            c->fSize = size;
+        }
+        c->fPrev = fChunk;
+        c->fUsed = 0;
+        fChunk = c;
+    }
+
+    void pop_chunk() {
+    // keep the largest emptied chunk around, to not thrash on chunk boundaries
+        Chunk* c = fChunk;
+        fChunk = c->fPrev;
+        if (fSpare && c->fSize <= fSpare->fSize)
+            ::operator delete((void*)c);
+        else {
+            if (fSpare) ::operator delete((void*)fSpare);
+            fSpare = c;
+        }
+    }
+
+private:
+    Chunk* fChunk = nullptr;
+    Chunk* fSpare = nullptr;
+    Frame* fTop   = nullptr;
+};
+
+const size_t ArgSlab::CHUNK_HDR = slab_align(sizeof(ArgSlab::Chunk));
+const size_t ArgSlab::FRAME_HDR = slab_align(sizeof(ArgSlab::Frame));
+
+static thread_local ArgSlab tArgSlab;
+
+// scoped frame, so that the slab unwinds if the call throws
+class ArgFrame {
+public:
+    ArgFrame(size_t bytes) : fMem(tArgSlab.allocate(bytes)) {}
+    ~ArgFrame() { tArgSlab.deallocate(fMem); }
+    ArgFrame(const ArgFrame&) = delete;
+    ArgFrame& operator=(const ArgFrame&) = delete;
+    void* get() const { return fMem; }
+
+private:
+    void* fMem;
+};
+
+} // unnamed namespace
+
+// call profiling ------------------------------------------------------------
+// Opt-in (CPPYY_PROFILE, or EnableProfiling) per-method call counts, cumulative
+// time, and log2-bucketed latencies. Counters are per thread and only updated
+// by their owning thread; snapshots sum over all threads. All counters live in
+// a global registry, so that their numbers survive thread exit.
+namespace {
+
+const int PROFILE_BUCKETS = CPPYY_PROFILE_BUCKETS;
+
+struct ProfileCounters {
+    ProfileCounters(void* key, bool is_dtor) : fKey(key), fIsDtor(is_dtor) {
+        for (int i = 0; i < PROFILE_BUCKETS; ++i) fHist[i].store(0, std::memory_order_relaxed);
+    }
+
+    void*                 fKey;         // method, or scope for destructors
+    bool                  fIsDtor;
+    std::atomic<uint64_t> fCalls{0};
+    std::atomic<uint64_t> fTotalNs{0};
+    std::atomic<uint64_t> fHist[PROFILE_BUCKETS];
+};
+
+class ProfileRegistry {
+public:
+    ProfileCounters* create(void* key, bool is_dtor) {
+        std::lock_guard<std::mutex> lock(fLock);
+        fAll.emplace_back(new ProfileCounters(key, is_dtor));
+        return fAll.back().get();
+    }
+
+    template<typename F>
+    void for_each(F f) {
+        std::lock_guard<std::mutex> lock(fLock);
+        for (auto& c : fAll) f(*c);
+    }
+
+private:
+    std::mutex fLock;
+    std::vector<std::unique_ptr<ProfileCounters>> fAll;
+};
+
+static ProfileRegistry gProfiles;
+
+struct ProfileThread {
+    ProfileCounters* get(void* key, bool is_dtor) {
+        auto& lookup = is_dtor ? fDestructors : fMethods;
+        auto it = lookup.find(key);
+        if (it != lookup.end())
+            return it->second;
+        ProfileCounters* c = gProfiles.create(key, is_dtor);
+        lookup.emplace(key, c);
+        return c;
+    }
+
+    std::unordered_map<void*, ProfileCounters*> fMethods;
+    std::unordered_map<void*, ProfileCounters*> fDestructors;
+};
+
+static thread_local ProfileThread tProfile;
+
+// times its own lifetime, if profiling is enabled, as count calls of key
+class ProfileScope {
+public:
+    ProfileScope(void* key, bool is_dtor = false, size_t count = 1) : fCounters(nullptr), fCount(count) {
+        if (gProfiling.load(std::memory_order_relaxed) && key && count) {
+            fCounters = tProfile.get(key, is_dtor);
+            fStart = std::chrono::steady_clock::now();
+        }
+    }
+    ~ProfileScope() {
+        if (!fCounters) return;
+        uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - fStart).count();
+        int bucket = 0;
+        for (uint64_t per_call = ns/fCount; per_call && bucket < PROFILE_BUCKETS-1; per_call >>= 1)
+            ++bucket;
+        fCounters->fCalls.fetch_add(fCount, std::memory_order_relaxed);
+        fCounters->fTotalNs.fetch_add(ns, std::memory_order_relaxed);
+        fCounters->fHist[bucket].fetch_add(fCount, std::memory_order_relaxed);
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileCounters* fCounters;
+    size_t fCount;
+    std::chrono::steady_clock::time_point fStart;
+};
+
+} // unnamed namespace
+
+// Calls in progress on this thread; the scratch arena can only be reset when
+// there are none, as it holds the temporaries of all of them.
+static thread_local int tCallDepth = 0;
+
+namespace {
+
+// Releases the arguments of a call once it returns, also if the callee throws.
+// If scratch is given, the earliest 'T' argument is merged into it rather than
+// released, so that a batch can keep the temporaries of all its rows alive.
+class ArgRelease {
+public:
+    ArgRelease(bool is_packed, size_t nargs, void* args, void** scratch) :
+        fPacked(is_packed), fNArgs(nargs), fArgs(args), fScratch(scratch) { ++tCallDepth; }
+    ~ArgRelease() {
+        --tCallDepth;
+        if (!fActive)
+            return;
+        void* mem = fPacked ? release_args_packed(fArgs, fNArgs) : release_args((Parameter*)fArgs, fNArgs);
+        if (fScratch)
+            *fScratch = tScratch.earliest(*fScratch, mem);
+        else if (mem)
+            tScratch.rewind(mem);
+    }
+    ArgRelease(const ArgRelease&) = delete;
+    ArgRelease& operator=(const ArgRelease&) = delete;
+
+    bool   fActive = false;
+
+private:
+    bool   fPacked;
+    size_t fNArgs;
+    void*  fArgs;
+    void** fScratch;
+};
+
+// Rewinds the scratch arena to the earliest temporary of a batch once it is
+// done, also if one of its rows throws.
+struct ScratchRewind {
+    void* fMem = nullptr;
+    ~ScratchRewind() { if (fMem) tScratch.rewind(fMem); }
+};
+
+} // unnamed namespace
+
+static inline
+void WrapperInvoke(const CallableCache::Entry* entry, bool is_direct, bool is_packed,
+    size_t nargs, void* args, void* self, void* result, void** vargs, void** scratch)
+{
+    ArgRelease release(is_packed, nargs, args, scratch);
+    if (nargs)
+        release.fActive = is_packed ? copy_args_packed(args, nargs, vargs) : copy_args((Parameter*)args, nargs, vargs);
+
+#ifdef CPPYY_FASTPATH_ABI
+    if (is_direct && entry->fFast.fAddress && nargs == entry->fFast.fNArgs)
+        fast_call(entry->fFast, vargs, self, result);
+    else
+#endif
+    {
+        //const auto& fgen = /* is_direct ? faceptr.fDirect : */ faceptr;
+        // CLING_CATCH_UNCAUGHT_
+        entry->fJC.Invoke(result, {vargs, nargs}, self);
+        // _CLING_CATCH_UNCAUGHT
+    }
+}
+
 static inline
-bool WrapperCall(Cppyy::TCppMethod_t method, size_t nargs, void* args_, void* self, void* result)
+void WrapperInvoke(const CallableCache::Entry* entry, bool is_direct, bool is_packed,
+    size_t nargs, void* args, void* self, void* result, void** scratch = nullptr)
+{
+    if (nargs <= SMALL_ARGS_N) {
+        void* smallbuf[SMALL_ARGS_N];
+        WrapperInvoke(entry, is_direct, is_packed, nargs, args, self, result, smallbuf, scratch);
+    } else {
+        ArgFrame frame(nargs*sizeof(void*));
+        WrapperInvoke(entry, is_direct, is_packed, nargs, args, self, result, (void**)frame.get(), scratch);
+    }
+}
+
+static inline
+bool WrapperCall(Cppyy::TCppMethod_t method, size_t nargs, void* args, void* self, void* result)
 {
-    Parameter* args = (Parameter*)args_;
     bool is_direct = nargs & DIRECT_CALL;
+    bool is_packed = nargs & PACKED_ARGS;
     nargs = CALL_NARGS(nargs);
 
     // if (!is_ready(wrap, is_direct))
     //     return false;        // happens with compilation error
 
-    if (Cpp::JitCall JC = Cpp::MakeFunctionCallable(method)) {
-        bool runRelease = false;
-        //const auto& fgen = /* is_direct ? faceptr.fDirect : */ faceptr;
-        if (nargs <= SMALL_ARGS_N) {
-            void* smallbuf[SMALL_ARGS_N];
-            if (nargs) runRelease = copy_args(args, nargs, smallbuf);
-            // CLING_CATCH_UNCAUGHT_
-            JC.Invoke(result, {smallbuf, nargs}, self);
-            // _CLING_CATCH_UNCAUGHT
-        } else {
-            std::vector<void*> buf(nargs);
-            runRelease = copy_args(args, nargs, buf.data());
-            // CLING_CATCH_UNCAUGHT_
-            JC.Invoke(result, {buf.data(), nargs}, self);
-            // _CLING_CATCH_UNCAUGHT
-        }
-        if (runRelease) release_args(args, nargs);
+    if (CallableCache::Entry* entry = gCallables.get(method)) {
+        ProfileScope prof(method);
+        WrapperInvoke(entry, is_direct, is_packed, nargs, args, self, result);
         return true;
     }
 
     return false;
 }
 
+// Run method over count rows of nargs arguments each, stored contiguously in
+// args, with selves[i] (if given) as receiver and results[i] (if given) for the
+// result of row i; the callable is resolved only once for the full batch. The
+// 'T' temporaries of all rows are released together after the last row.
+static inline
+bool WrapperCallBatch(Cppyy::TCppMethod_t method, Cppyy::TCppObject_t* selves,
+    size_t nargs, void* args, void* results, size_t rsize, size_t count)
+{
+    bool is_direct = nargs & DIRECT_CALL;
+    bool is_packed = nargs & PACKED_ARGS;
+    nargs = CALL_NARGS(nargs);
+    size_t stride = is_packed ? PackedFunctionArgsSize(nargs) : nargs*sizeof(Parameter);
+
+    CallableCache::Entry* entry = gCallables.get(method);
+    if (!entry)
+        return false;
+
+    ProfileScope prof(method, false, count);
+    ScratchRewind scratch;
+    for (size_t i = 0; i < count; ++i) {
+        WrapperInvoke(entry, is_direct, is_packed, nargs, (char*)args + i*stride,
+            selves ? (void*)selves[i] : nullptr, results ? (char*)results + i*rsize : nullptr,
+            &scratch.fMem);
+    }
+
+    return true;
+}
+
 template<typename T>
 static inline
 T CallT(Cppyy::TCppMethod_t method, Cppyy::TCppObject_t self, size_t nargs, void* args)
@@ -848,42 +2449,131 @@ void* Cppyy::CallR(TCppMethod_t method, TCppObject_t self, size_t nargs, void* a
     return nullptr;
 }
 
+#define CPPYY_IMP_CALL_BATCH(typecode, rtype)                                \
+bool Cppyy::Call##typecode##Batch(TCppMethod_t method, TCppObject_t* selves, \
+    size_t nargs, void* args, rtype* results, size_t count)                  \
+{                                                                            \
+    _IMP_CALL_PRINT_STMT(rtype)                                              \
+    return WrapperCallBatch(method, selves, nargs, args, results, sizeof(rtype), count);\
+}
+
+bool Cppyy::CallVBatch(TCppMethod_t method, TCppObject_t* selves,
+    size_t nargs, void* args, size_t count)
+{
+    return WrapperCallBatch(method, selves, nargs, args, nullptr, 0, count);
+}
+
+CPPYY_IMP_CALL_BATCH(B,  unsigned char)
+CPPYY_IMP_CALL_BATCH(C,  char         )
+CPPYY_IMP_CALL_BATCH(H,  short        )
+CPPYY_IMP_CALL_BATCH(I,  int          )
+CPPYY_IMP_CALL_BATCH(L,  long         )
+CPPYY_IMP_CALL_BATCH(LL, long long    )
+CPPYY_IMP_CALL_BATCH(F,  float        )
+CPPYY_IMP_CALL_BATCH(D,  double       )
+CPPYY_IMP_CALL_BATCH(LD, long double  )
+CPPYY_IMP_CALL_BATCH(R,  void*        )
+
 char* Cppyy::CallS(
     TCppMethod_t method, TCppObject_t self, size_t nargs, void* args, size_t* length)
 {
     char* cstr = nullptr;
     // TClassRef cr("std::string"); // TODO: Why is this required?
-    std::string* cppresult = (std::string*)malloc(sizeof(std::string));
+    alignas(std::string) char storage[sizeof(std::string)];
+    std::string* cppresult = (std::string*)storage;
     if (WrapperCall(method, nargs, args, self, (void*)cppresult)) {
         cstr = cppstring_to_cstring(*cppresult);
         *length = cppresult->size();
         cppresult->std::string::~basic_string();
     } else
         *length = 0;
-    free((void*)cppresult);
     return cstr;
 }
 
+Cppyy::TCppObject_t Cppyy::CallStdString(
+    TCppMethod_t method, TCppObject_t self, size_t nargs, void* args)
+{
+// Hand the std::string produced by method to the caller as-is, without copying
+// its contents; release with FreeStdString().
+    void* cppresult = ::operator new(sizeof(std::string));
+    if (WrapperCall(method, nargs, args, self, cppresult))
+        return (TCppObject_t)cppresult;
+    ::operator delete(cppresult);
+    return (TCppObject_t)0;
+}
+
+void Cppyy::FreeStdString(TCppObject_t str)
+{
+    delete (std::string*)str;
+}
+
+size_t Cppyy::CallSBuffer(TCppMethod_t method, TCppObject_t self,
+    size_t nargs, void* args, char** buffer, size_t* capacity)
+{
+// Copy the string result into the caller's malloc'ed *buffer of *capacity bytes,
+// growing it as needed, so that repeated calls do not allocate. Returns the
+// length, or (size_t)-1 on failure, in which case *buffer is left as is.
+    alignas(std::string) char storage[sizeof(std::string)];
+    std::string* cppresult = (std::string*)storage;
+    if (!WrapperCall(method, nargs, args, self, (void*)cppresult))
+        return (size_t)-1;
+
+    size_t length = cppresult->size();
+    if (!*buffer || *capacity < length+1) {
+        char* grown = (char*)realloc(*buffer, length+1);
+        if (!grown) {
+            cppresult->std::string::~basic_string();
+            return (size_t)-1;
+        }
+        *buffer = grown;
+        *capacity = length+1;
+    }
+    memcpy(*buffer, cppresult->c_str(), length+1);
+    cppresult->std::string::~basic_string();
+    return length;
+}
+
 Cppyy::TCppObject_t Cppyy::CallConstructor(
     TCppMethod_t method, TCppScope_t klass, size_t nargs, void* args)
 {
-    void* obj = nullptr;
-    WrapperCall(method, nargs, args, nullptr, &obj);
+    // a non-null self makes the constructor wrapper placement-new into *result
+    PoolScope ps = pool_scope(klass);
+    void* mem = ps.fPooled ? tPool.allocate(ps.fSize) : nullptr;
+    void* obj = mem;
+    if (!WrapperCall(method, nargs, args, mem, &obj)) {
+        tPool.release(mem, ps.fSize);
+        return (TCppObject_t)0;
+    }
+    if (mem && obj != mem)      // wrapper allocated by itself
+        tPool.release(mem, ps.fSize);
     return (TCppObject_t)obj;
 }
 
 void Cppyy::CallDestructor(TCppScope_t scope, TCppObject_t self)
 {
+    ProfileScope prof(scope, /*is_dtor=*/true);
     Cpp::Destruct(self, scope, /*withFree=*/false);
 }
 
 Cppyy::TCppObject_t Cppyy::CallO(TCppMethod_t method,
     TCppObject_t self, size_t nargs, void* args, TCppType_t result_type)
 {
-    void* obj = ::operator new(Cpp::GetSizeOfType(result_type));
+// results of classes with their own operator new are allocated as by Allocate
+// and are to be freed through Deallocate, as they are not pooled
+    PoolScope ps = pool_type(result_type);
+    if (!ps.fPooled) {
+        TCppScope_t scope = Cpp::GetScopeFromType(result_type);
+        void* obj = Cpp::Allocate(scope);
+        if (WrapperCall(method, nargs, args, self, obj))
+            return (TCppObject_t)obj;
+        Cpp::Deallocate(scope, obj);
+        return (TCppObject_t)0;
+    }
+
+    void* obj = tPool.allocate(ps.fSize);
     if (WrapperCall(method, nargs, args, self, obj))
         return (TCppObject_t)obj;
-    ::operator delete(obj);
+    tPool.release(obj, ps.fSize);
     return (TCppObject_t)0;
 }
 
@@ -892,16 +2582,41 @@ Cppyy::TCppFuncAddr_t Cppyy::GetFunctionAddress(TCppMethod_t method, bool check_
     return (TCppFuncAddr_t) Cpp::GetFunctionAddress(method);
 }
 
+void Cppyy::EnableProfiling(bool enable)
+{
+    gProfiling = enable;
+}
+
+void Cppyy::ResetProfile()
+{
+    gProfiles.for_each([](ProfileCounters& c) {
+        c.fCalls.store(0, std::memory_order_relaxed);
+        c.fTotalNs.store(0, std::memory_order_relaxed);
+        for (int i = 0; i < PROFILE_BUCKETS; ++i)
+            c.fHist[i].store(0, std::memory_order_relaxed);
+    });
+}
+
+void Cppyy::InvalidateCallables(TCppMethod_t method)
+{
+// Drop the memoized callable of method (or of all methods if null); to be used
+// when declarations are unloaded, as their addresses may be reused. The dropped
+// entries and the replaced table are deliberately leaked until shutdown, as
+// there is no way of knowing when concurrent callers are done with them.
+    gCallables.invalidate(method);
+}
+
 
 // handling of function argument buffer --------------------------------------
 void* Cppyy::AllocateFunctionArgs(size_t nargs)
 {
-    return new Parameter[nargs];
+// Parameter is trivial, so the frame needs neither construction nor destruction
+    return tArgSlab.allocate(nargs*sizeof(Parameter));
 }
 
 void Cppyy::DeallocateFunctionArgs(void* args)
 {
-    delete [] (Parameter*)args;
+    tArgSlab.deallocate(args);
 }
 
 size_t Cppyy::GetFunctionArgSizeof()
@@ -914,6 +2629,35 @@ size_t Cppyy::GetFunctionArgTypeoffset()
     return offsetof(Parameter, fTypeCode);
 }
 
+void* Cppyy::AllocateScratch(size_t size)
+{
+// storage for a temporary argument, to be passed with type code 'T'; it is
+// released after the call that receives it
+    return tScratch.allocate(size);
+}
+
+void Cppyy::ResetScratch()
+{
+// Drop all temporaries of this thread, e.g. of calls that were never made. Not
+// allowed while calls are in progress on this thread (e.g. from a callback that
+// re-enters C++), as it would free their arguments; ignored in that case.
+    assert(!tCallDepth && "ResetScratch while calls are in progress");
+    if (tCallDepth)
+        return;
+    tScratch.reset();
+}
+
+void* Cppyy::AllocatePackedFunctionArgs(size_t nargs)
+{
+// frame for a call with PACKED_ARGS; release with DeallocateFunctionArgs
+    return tArgSlab.allocate(PackedFunctionArgsSize(nargs));
+}
+
+size_t Cppyy::GetPackedFunctionArgsSize(size_t nargs)
+{
+    return PackedFunctionArgsSize(nargs);
+}
+
 
 // scope reflection information ----------------------------------------------
 bool Cppyy::IsNamespace(TCppScope_t scope)
@@ -1133,6 +2877,109 @@ bool Cppyy::IsVariable(TCppScope_t scope)
 // }
 //
 //
+// Per-scope index of the names of C++ entities, sorted for prefix searches. An
+// index is built on first use and rebuilt only for the scopes that are queried
+// after user code was declared, so listing a scope does not walk the AST again
+// as long as nothing was added (the backend's internal declarations, e.g. for
+// type lookups, do not count). Indices are shared, immutable
+// snapshots: cursors keep theirs alive while a rebuild takes place.
+namespace {
+
+typedef std::vector<std::string> NameList;
+
+class NameIndex {
+public:
+    std::shared_ptr<const NameList> get(Cppyy::TCppScope_t scope) {
+        uint64_t generation = gNameGeneration.load(std::memory_order_acquire);
+        {
+            std::shared_lock<std::shared_mutex> lock(fLock);
+            auto entry = fScopes.find(scope);
+            if (entry != fScopes.end() && entry->second.fGeneration == generation)
+                return entry->second.fNames;
+        }
+
+        std::shared_ptr<const NameList> names = build(scope);
+        std::unique_lock<std::shared_mutex> lock(fLock);
+        fScopes[scope] = Entry{generation, names};
+        return names;
+    }
+
+private:
+    static std::shared_ptr<const NameList> build(Cppyy::TCppScope_t scope) {
+        bool is_global = scope == Cpp::GetGlobalScope();
+        std::set<std::string> all;
+        Cpp::GetAllCppNames(scope, all);
+
+        std::set<std::string> filtered;
+        for (const std::string& name : all) {
+            if (name.empty() || name[0] == '_' || name.compare(0, 8, "operator") == 0 ||
+                    name.find(".h") != std::string::npos)
+                continue;
+            std::string outer = name.substr(0, name.find('<'));
+            if (is_global && gInitialNames.find(outer) != gInitialNames.end())
+                continue;
+            filtered.insert(outer);
+        }
+        return std::make_shared<const NameList>(filtered.begin(), filtered.end());
+    }
+
+    struct Entry {
+        uint64_t fGeneration;
+        std::shared_ptr<const NameList> fNames;
+    };
+
+    std::shared_mutex fLock;
+    std::unordered_map<Cppyy::TCppScope_t, Entry> fScopes;
+};
+
+static NameIndex gNameIndex;
+
+struct NameCursor {
+    std::shared_ptr<const NameList> fNames;
+    NameList::const_iterator fCurrent;
+    std::string fPrefix;
+};
+
+} // unnamed namespace
+
+void Cppyy::GetAllCppNames(TCppScope_t scope, std::set<std::string>& cppnames)
+{
+// Collect all known names of C++ entities under scope. This is useful for IDEs
+// employing tab-completion, for example. Note that functions names need not be
+// unique as they can be overloaded.
+    wait_for_interpreter();     // for gInitialNames
+    if (!scope) scope = Cpp::GetGlobalScope();
+    lazy_std_names(scope);
+    std::shared_ptr<const NameList> names = gNameIndex.get(scope);
+    cppnames.insert(names->begin(), names->end());
+}
+
+Cppyy::TCppNameCursor_t Cppyy::OpenNameCursor(TCppScope_t scope, const std::string& prefix)
+{
+    wait_for_interpreter();
+    if (!scope) scope = Cpp::GetGlobalScope();
+    lazy_std_names(scope);
+    NameCursor* cursor = new NameCursor{gNameIndex.get(scope), {}, prefix};
+    cursor->fCurrent = std::lower_bound(cursor->fNames->begin(), cursor->fNames->end(), prefix);
+    return (TCppNameCursor_t)cursor;
+}
+
+const char* Cppyy::NextName(TCppNameCursor_t handle)
+{
+// returns nullptr once all names with the requested prefix have been seen; the
+// result remains valid until the cursor is closed
+    NameCursor* cursor = (NameCursor*)handle;
+    if (cursor->fCurrent == cursor->fNames->end() ||
+            cursor->fCurrent->compare(0, cursor->fPrefix.size(), cursor->fPrefix) != 0)
+        return nullptr;
+    return (cursor->fCurrent++)->c_str();
+}
+
+void Cppyy::CloseNameCursor(TCppNameCursor_t handle)
+{
+    delete (NameCursor*)handle;
+}
+
 // // class reflection information ----------------------------------------------
 std::vector<Cppyy::TCppScope_t> Cppyy::GetUsingNamespaces(TCppScope_t scope)
 {
@@ -1244,11 +3091,188 @@ bool Cppyy::IsSmartPtr(TCppScope_t klass)
 
 
 // type offsets --------------------------------------------------------------
+// Offsets are cached per (derived, base) pair. Static offsets are not correct
+// for paths through a virtual base (unless for a complete derived object), so
+// if reflection can not rule out virtual bases, the first cast with an actual
+// address JITs a per-pair function that tells whether the path is virtual and,
+// if so, computes the offset from the object itself (through its vtable) on
+// each cast.
+namespace {
+
+typedef bool (*BaseOffsetFunc_t)(void* addr, int direction, ptrdiff_t* offset, bool* nonvirtual);
+
+struct BaseOffset {
+    intptr_t         fStatic = -1;      // from Cpp::GetBaseClassOffset
+    char             fPath   = 'u';     // 'u'nknown, 'n'on-virtual, 'v'irtual, 'x' no function
+    BaseOffsetFunc_t fFunc   = nullptr;
+};
+
+struct BaseOffsetKeyHash {
+    size_t operator()(const std::pair<void*, void*>& key) const {
+        return std::hash<void*>()(key.first) ^ (std::hash<void*>()(key.second) << 1);
+    }
+};
+
+// A class with virtual bases anywhere in its hierarchy is dynamic, i.e. it has a
+// vtable pointer at offset 0 (its own, or that of its primary base). A class for
+// which other data is found at offset 0 therefore only has non-virtual bases.
+// Inconclusive cases count as dynamic, which merely costs a JIT-ed function.
+static bool is_dynamic_class(Cppyy::TCppScope_t klass)
+{
+    if (!Cpp::IsClass(klass) || !Cpp::IsComplete(klass))
+        return true;
+    if (Cpp::SizeOf(klass) < sizeof(void*))
+        return false;
+
+    Cppyy::MethodSpan methods;
+    if (Cppyy::GetClassMethodsSpan(klass, methods)) {
+        for (Cppyy::TCppMethod_t m : methods) {
+            if (Cpp::IsVirtualMethod(m))
+                return true;
+        }
+    }
+
+    for (Cppyy::TCppScope_t var : Cpp::GetDatamembers(klass)) {
+        if (!Cpp::IsStaticVariable(var) && Cpp::GetVariableOffset(var) == 0)
+            return false;
+    }
+
+    for (Cppyy::TCppIndex_t ibase = 0; ibase < Cpp::GetNumBases(klass); ++ibase) {
+        Cppyy::TCppScope_t base = Cpp::GetBaseClass(klass, ibase);
+        if (Cpp::GetBaseClassOffset(klass, base) != 0)
+            continue;
+        if (is_dynamic_class(base))
+            return true;
+        if (1 < Cpp::SizeOf(base))      // i.e. not empty
+            return false;
+    }
+
+    return true;
+}
+
+static std::shared_mutex gBaseOffsetLock;
+static std::unordered_map<std::pair<void*, void*>, BaseOffset, BaseOffsetKeyHash> gBaseOffsets;
+static std::mutex gBaseOffsetJITLock;
+
+// to be called with gBaseOffsetJITLock held
+static BaseOffsetFunc_t jit_base_offset(Cppyy::TCppScope_t derived, Cppyy::TCppScope_t base)
+{
+    static unsigned long long func_count = 0;
+    if (!func_count) {
+    // the per-pair functions only instantiate this template, as the discarded
+    // branches of if constexpr are only exempt from checking inside templates;
+    // upcasts are C-style, as those ignore access, so that private and protected
+    // bases work, too (static_cast and dynamic_cast do not, so a downcast through
+    // a non-public virtual base fails, as does one of an object of another type)
+        Cpp::Declare(
+            "#include <type_traits>\n"
+            "namespace __cppyy_internal {\n"
+            "template<class D, class B, class = void>\n"
+            "struct is_nonvirtual_base : std::false_type {};\n"
+            "template<class D, class B>\n"
+            "struct is_nonvirtual_base<D, B, decltype((void)static_cast<D*>((B*)nullptr))> : std::true_type {};\n"
+            "template<class D, class B>\n"
+            "bool base_offset(void* addr, int direction, ptrdiff_t* offset, bool* nonvirtual) {\n"
+            "  *nonvirtual = is_nonvirtual_base<D, B>::value;\n"
+            "  if constexpr (is_nonvirtual_base<D, B>::value) {\n"
+            "    *offset = (char*)static_cast<B*>((D*)addr) - (char*)addr;\n"
+            "    return true;\n"
+            "  } else {\n"
+            "    if (0 <= direction) {\n"
+            "      *offset = (char*)(B*)(D*)addr - (char*)addr;\n"
+            "      return true;\n"
+            "    }\n"
+            "    if constexpr (std::is_polymorphic<B>::value) {\n"
+            "      if (D* d = dynamic_cast<D*>((B*)addr)) {\n"
+            "        *offset = (char*)d - (char*)addr;\n"
+            "        return true;\n"
+            "      }\n"
+            "    }\n"
+            "    return false;\n"
+            "  }\n"
+            "}\n"
+            "}", /*silent=*/false);
+    }
+
+    std::string fname = "__cppyy_base_offset_" + std::to_string(func_count++);
+    std::string code = "namespace __cppyy_internal {\n"
+        "bool " + fname + "(void* addr, int direction, ptrdiff_t* offset, bool* nonvirtual) {\n"
+        "  return base_offset< ::" + Cppyy::GetScopedFinalName(derived) + ", ::" + Cppyy::GetScopedFinalName(base) +
+        " >(addr, direction, offset, nonvirtual);\n"
+        "}\n"
+        "}";
+
+    bool failed = Cpp::Declare(code.c_str(), /*silent=*/false);
+    bump_decl_generation();
+    if (failed)
+        return nullptr;
+
+    Cppyy::TCppScope_t func = Cpp::GetNamed(fname, Cpp::GetScope("__cppyy_internal"));
+    return func ? (BaseOffsetFunc_t)Cpp::GetFunctionAddress(func) : nullptr;
+}
+
+} // unnamed namespace
+
 ptrdiff_t Cppyy::GetBaseOffset(TCppScope_t derived, TCppScope_t base,
     TCppObject_t address, int direction, bool rerror)
 {
-    intptr_t offset = Cpp::GetBaseClassOffset(derived, base);
-    
+    assert_interpreter_ready();
+    auto key = std::make_pair((void*)derived, (void*)base);
+    BaseOffset bo;
+    bool found = false;
+    {
+        std::shared_lock<std::shared_mutex> lock(gBaseOffsetLock);
+        auto it = gBaseOffsets.find(key);
+        if (it != gBaseOffsets.end()) {
+            bo = it->second;
+            found = true;
+        }
+    }
+
+    if (!found) {
+        bo.fStatic = Cpp::GetBaseClassOffset(derived, base);
+        if (!is_dynamic_class(derived))
+            bo.fPath = 'n';
+        std::unique_lock<std::shared_mutex> lock(gBaseOffsetLock);
+        gBaseOffsets.emplace(key, bo);
+    }
+
+// the first cast with an address classifies the path; its result is reused below
+    bool computed = false, ok = false;
+    ptrdiff_t result = 0;
+    if (address && bo.fPath == 'u') {
+        std::lock_guard<std::mutex> jit_lock(gBaseOffsetJITLock);
+        {
+        // another thread may have classified the path while this one was waiting
+            std::shared_lock<std::shared_mutex> lock(gBaseOffsetLock);
+            bo = gBaseOffsets.find(key)->second;
+        }
+        if (bo.fPath == 'u') {
+            bo.fFunc = jit_base_offset(derived, base);
+            bo.fPath = 'x';
+            if (bo.fFunc) {
+                bool nonvirtual = false;
+                ok = bo.fFunc(address, direction, &result, &nonvirtual);
+                bo.fPath = nonvirtual ? 'n' : 'v';
+                computed = true;
+            }
+            std::unique_lock<std::shared_mutex> lock(gBaseOffsetLock);
+            gBaseOffsets[key] = bo;
+        }
+    }
+
+    if (address && bo.fPath == 'v') {
+        if (!computed) {
+            bool nonvirtual = false;
+            ok = bo.fFunc(address, direction, &result, &nonvirtual);
+        }
+    // the static offset is wrong for a virtual path, so a failed cast is an error
+        if (!ok)
+            return rerror ? (ptrdiff_t)-1 : 0;
+        return result;
+    }
+
+    intptr_t offset = bo.fStatic;
     if (offset == -1)   // Cling error, treat silently
         return rerror ? (ptrdiff_t)offset : 0;
 
@@ -1287,17 +3311,159 @@ ptrdiff_t Cppyy::GetBaseOffset(TCppScope_t derived, TCppScope_t base,
 //     return (TCppIndex_t)0;         // unknown class?
 // }
 
+// Per-class method indices: the full method list and the overload sets by name,
+// each kept in immutable storage, so that the returned spans remain valid. Only
+// completed classes are indexed; namespaces are open and always go through Clang
+// lookup. The members of a completed class are fixed (implicit ones are declared
+// when the methods are listed, and specializations of member templates are not
+// found by iteration or lookup), so entries are only refreshed when new code came
+// in, i.e. once gNameGeneration moves on, not on every instantiation. A refresh
+// that finds the same methods keeps the existing storage; storage that was handed
+// out is retained rather than replaced.
+namespace {
+
+struct MethodSet {
+    Cppyy::MethodSpan fSpan;
+    uint64_t          fGeneration;
+};
+
+struct MethodIndex {
+    bool                                            fHasAll = false;
+    MethodSet                                       fAll;
+    std::unordered_map<std::string, MethodSet>      fByName;
+    std::deque<std::vector<Cppyy::TCppMethod_t>>    fSets;   // backing store of fAll and fByName
+};
+
+class MethodIndexCache {
+public:
+    bool all(Cppyy::TCppScope_t scope, Cppyy::MethodSpan& span) {
+        {
+            std::shared_lock<std::shared_mutex> lock(fLock);
+            auto idx = fIndices.find(scope);
+            if (idx != fIndices.end() && idx->second->fHasAll && current(idx->second->fAll)) {
+                span = idx->second->fAll.fSpan;
+                return true;
+            }
+        }
+
+        if (!indexable(scope))
+            return false;
+
+        uint64_t generation = gNameGeneration.load(std::memory_order_acquire);
+        std::vector<Cppyy::TCppMethod_t> methods = Cpp::GetClassMethods(scope);
+        std::unique_lock<std::shared_mutex> lock(fLock);
+        MethodIndex& idx = index(scope);
+        if (!idx.fHasAll)
+            idx.fAll = store(idx, methods, generation);
+        else
+            update(idx, idx.fAll, methods, generation);
+        idx.fHasAll = true;
+        span = idx.fAll.fSpan;
+        return true;
+    }
+
+    bool named(Cppyy::TCppScope_t scope, const std::string& name, Cppyy::MethodSpan& span) {
+        {
+            std::shared_lock<std::shared_mutex> lock(fLock);
+            auto idx = fIndices.find(scope);
+            if (idx != fIndices.end()) {
+                auto set = idx->second->fByName.find(name);
+                if (set != idx->second->fByName.end() && current(set->second)) {
+                    span = set->second.fSpan;
+                    return true;
+                }
+            }
+        }
+
+        if (!indexable(scope))
+            return false;
+
+    // includes base class members and using declarations, unlike fAll
+        uint64_t generation = gNameGeneration.load(std::memory_order_acquire);
+        std::vector<Cppyy::TCppMethod_t> methods = Cpp::GetFunctionsUsingName(scope, name);
+        std::unique_lock<std::shared_mutex> lock(fLock);
+        MethodIndex& idx = index(scope);
+        auto set = idx.fByName.find(name);
+        if (set == idx.fByName.end())
+            set = idx.fByName.emplace(name, store(idx, methods, generation)).first;
+        else
+            update(idx, set->second, methods, generation);
+        span = set->second.fSpan;
+        return true;
+    }
+
+private:
+    static bool current(const MethodSet& set) {
+        return set.fGeneration == gNameGeneration.load(std::memory_order_acquire);
+    }
+
+    static MethodSet store(MethodIndex& idx, std::vector<Cppyy::TCppMethod_t>& methods, uint64_t generation) {
+        idx.fSets.emplace_back(std::move(methods));
+        MethodSet set;
+        set.fSpan.fBegin = idx.fSets.back().data();
+        set.fSpan.fSize  = idx.fSets.back().size();
+        set.fGeneration  = generation;
+        return set;
+    }
+
+    // refresh a stale set, reusing its storage if the methods are unchanged
+    static void update(MethodIndex& idx, MethodSet& set,
+            std::vector<Cppyy::TCppMethod_t>& methods, uint64_t generation) {
+        if (generation < set.fGeneration)
+            return;             // raced with a more recent refresh
+        if (methods.size() == set.fSpan.fSize && std::equal(methods.begin(), methods.end(), set.fSpan.begin()))
+            set.fGeneration = generation;
+        else
+            set = store(idx, methods, generation);
+    }
+
+    static bool indexable(Cppyy::TCppScope_t scope) {
+        assert_interpreter_ready();
+        return scope && Cpp::IsClass(scope) && Cpp::IsComplete(scope);
+    }
+
+    MethodIndex& index(Cppyy::TCppScope_t scope) {
+        std::unique_ptr<MethodIndex>& idx = fIndices[scope];
+        if (!idx) idx.reset(new MethodIndex);
+        return *idx;
+    }
+
+    std::shared_mutex fLock;
+    std::unordered_map<Cppyy::TCppScope_t, std::unique_ptr<MethodIndex>> fIndices;
+};
+
+static MethodIndexCache gMethodIndices;
+
+} // unnamed namespace
+
 std::vector<Cppyy::TCppMethod_t> Cppyy::GetClassMethods(TCppScope_t scope)
 {
+    MethodSpan span;
+    if (gMethodIndices.all(scope, span))
+        return std::vector<TCppMethod_t>(span.begin(), span.end());
     return Cpp::GetClassMethods(scope);
 }
 
 std::vector<Cppyy::TCppScope_t> Cppyy::GetMethodsFromName(
     TCppScope_t scope, const std::string& name)
 {
+    MethodSpan span;
+    if (gMethodIndices.named(scope, name, span))
+        return std::vector<TCppMethod_t>(span.begin(), span.end());
     return Cpp::GetFunctionsUsingName(scope, name);
 }
 
+bool Cppyy::GetClassMethodsSpan(TCppScope_t scope, MethodSpan& span)
+{
+    return gMethodIndices.all(scope, span);
+}
+
+bool Cppyy::GetMethodsFromNameSpan(
+    TCppScope_t scope, const std::string& name, MethodSpan& span)
+{
+    return gMethodIndices.named(scope, name, span);
+}
+
 // Cppyy::TCppMethod_t Cppyy::GetMethod(TCppScope_t scope, TCppIndex_t idx)
 // {
 //     TClassRef& cr = type_from_handle(scope);
@@ -1471,6 +3637,122 @@ bool Cppyy::IsTemplatedMethod(TCppMethod_t method)
 //     return n2.compare(0, n1.size(), n1) == 0;
 // }
 //
+
+// Instantiated method templates, keyed on (scope, name, proto). Successful
+// instantiations are permanent; failures are remembered only until new
+// declarations become available.
+namespace {
+
+struct MethodTemplateKeyHash {
+    size_t operator()(const std::pair<void*, std::string>& key) const {
+        return std::hash<void*>()(key.first) ^ std::hash<std::string>()(key.second);
+    }
+};
+
+struct MethodTemplateEntry {
+    Cppyy::TCppMethod_t fMethod;
+    uint64_t            fGeneration;    // for failures only
+};
+
+static std::shared_mutex gMethodTemplateLock;
+static std::unordered_map<std::pair<void*, std::string>, MethodTemplateEntry, MethodTemplateKeyHash> gMethodTemplates;
+
+// split a template argument list at its top-level commas
+static std::vector<std::string> split_template_args(const std::string& args)
+{
+    std::vector<std::string> result;
+    int nesting = 0;
+    std::string::size_type start = 0;
+    for (std::string::size_type i = 0; i <= args.size(); ++i) {
+        char c = i < args.size() ? args[i] : ',';
+        if (c == '<' || c == '(' || c == '[') ++nesting;
+        else if (c == '>' || c == ')' || c == ']') --nesting;
+        else if (c == ',' && !nesting) {
+            std::string::size_type b = args.find_first_not_of(' ', start);
+            std::string::size_type e = args.find_last_not_of(' ', i-1);
+            result.push_back(b == std::string::npos || b >= i ? "" : args.substr(b, e-b+1));
+            start = i+1;
+        }
+    }
+    return result;
+}
+
+// integral literals, such as "3", "-1", "8u", or "true", are non-type arguments
+static bool is_integral_literal(const std::string& arg)
+{
+    if (arg == "true" || arg == "false")
+        return true;
+    std::string::size_type i = (!arg.empty() && (arg[0] == '-' || arg[0] == '+')) ? 1 : 0;
+    if (i == arg.size() || !isdigit((unsigned char)arg[i]))
+        return false;
+    bool hex = arg.compare(i, 2, "0x") == 0 || arg.compare(i, 2, "0X") == 0;
+    if (hex) i += 2;
+    std::string::size_type end = i;
+    while (end < arg.size() && (hex ? isxdigit((unsigned char)arg[end]) : isdigit((unsigned char)arg[end])))
+        ++end;
+    return end != i && arg.find_first_not_of("uUlL", end) == std::string::npos;
+}
+
+// explicit template arguments; values holds the text of non-type arguments,
+// which the TemplateArgInfo entries point into. Returns true on failure.
+static bool explicit_template_args(const std::string& args,
+    std::vector<Cpp::TemplateArgInfo>& targs, std::deque<std::string>& values)
+{
+    for (const std::string& arg : split_template_args(args)) {
+        if (is_integral_literal(arg)) {
+            Cppyy::TCppType_t type = Cppyy::GetType(arg, /*enable_slow_lookup=*/true);
+            if (!type)
+                return true;
+            values.push_back(arg);
+            targs.emplace_back(type, values.back().c_str());
+        } else if (arg.empty() || Cppyy::AppendTypesSlow(arg, targs))
+            return true;
+    }
+    return false;
+}
+
+static Cppyy::TCppMethod_t instantiate_method_template(
+    Cppyy::TCppScope_t scope, const std::string& name, const std::string& proto)
+{
+// only explicit template arguments are supported, e.g. "f<int,double>"; proto
+// holds the argument types of the call, e.g. "int,const std::string&", which
+// select among overloaded templates of the same name
+    if (name.empty() || name.back() != '>')
+        return nullptr;
+    std::string::size_type pos = name.find('<');
+    if (pos == std::string::npos || pos == 0)
+        return nullptr;
+
+    std::vector<Cppyy::TCppMethod_t> candidates;
+    Cpp::GetClassTemplatedMethods(name.substr(0, pos), scope, candidates);
+    if (candidates.empty())
+        return nullptr;
+
+// without a prototype, there is nothing to choose by, unless there is no choice,
+// in which case the explicit arguments have to fully specify the template
+    if (proto.empty()) {
+        if (candidates.size() != 1)
+            return nullptr;     // ambiguous
+        std::string fullname = scope == Cpp::GetGlobalScope() ? name :
+            Cppyy::GetScopedFinalName(scope) + "::" + name;
+        return Cpp::InstantiateTemplateFunctionFromString(fullname.c_str());
+    }
+
+    std::vector<Cpp::TemplateArgInfo> targs;
+    std::deque<std::string> values;
+    std::string explicit_args = name.substr(pos+1, name.size()-pos-2);
+    if (!explicit_args.empty() && explicit_template_args(explicit_args, targs, values))
+        return nullptr;
+
+    std::vector<Cpp::TemplateArgInfo> argtypes;
+    if (Cppyy::AppendTypesSlow(proto, argtypes))
+        return nullptr;
+
+    return Cpp::BestOverloadFunctionMatch(candidates, targs, argtypes);
+}
+
+} // unnamed namespace
+
 Cppyy::TCppMethod_t Cppyy::GetMethodTemplate(
     TCppScope_t scope, const std::string& name, const std::string& proto)
 {
@@ -1550,8 +3832,25 @@ Cppyy::TCppMethod_t Cppyy::GetMethodTemplate(
 //         }
 //     }
 
-// failure ...
-    return (TCppMethod_t)nullptr;
+    auto key = std::make_pair((void*)scope, name + '\0' + proto);
+    uint64_t generation = gDeclGeneration.load(std::memory_order_acquire);
+    {
+        std::shared_lock<std::shared_mutex> lock(gMethodTemplateLock);
+        auto it = gMethodTemplates.find(key);
+        if (it != gMethodTemplates.end() &&
+                (it->second.fMethod || it->second.fGeneration == generation))
+            return it->second.fMethod;
+    }
+
+    TCppMethod_t method = instantiate_method_template(scope, name, proto);
+    if (method) bump_decl_generation();     // new specialization
+
+// have the callable ready, so that the first call is a cache hit as well
+    if (method) gCallables.get(method);
+
+    std::unique_lock<std::shared_mutex> lock(gMethodTemplateLock);
+    gMethodTemplates[key] = MethodTemplateEntry{method, gDeclGeneration.load(std::memory_order_acquire)};
+    return method;
 }
 //
 // static inline
@@ -1841,14 +4140,98 @@ bool Cppyy::IsConstVar(TCppScope_t var)
 //         }
 //     }
 
-// // this default return only means that the data will be writable, not that it will
-// // be unreadable or otherwise misrepresented
-//     return false;
-// }
+// // this default return only means that the data will be writable, not that it will
+// // be unreadable or otherwise misrepresented
+//     return false;
+// }
+
+std::vector<long int>  Cppyy::GetDimensions(TCppType_t type)
+{
+    return Cpp::GetDimensions(type);
+}
+
+// Per-class datamember layout tables, built in one pass over the members and
+// kept for good. As with the method indices, only completed classes qualify.
+namespace {
+
+struct DatamemberLayoutTable {
+    std::vector<Cppyy::DatamemberLayout> fEntries;
+    std::vector<long int>                fDims;     // backing store of fEntries
+};
+
+class DatamemberLayoutCache {
+public:
+    const DatamemberLayoutTable* get(Cppyy::TCppScope_t scope) {
+        {
+            std::shared_lock<std::shared_mutex> lock(fLock);
+            auto table = fTables.find(scope);
+            if (table != fTables.end())
+                return table->second.get();
+        }
+
+        if (!scope || !Cpp::IsClass(scope) || !Cpp::IsComplete(scope))
+            return nullptr;
+
+        std::unique_ptr<DatamemberLayoutTable> table = build(scope);
+        std::unique_lock<std::shared_mutex> lock(fLock);
+        std::unique_ptr<DatamemberLayoutTable>& entry = fTables[scope];
+        if (!entry) entry.swap(table);
+        return entry.get();
+    }
+
+private:
+    static std::unique_ptr<DatamemberLayoutTable> build(Cppyy::TCppScope_t scope) {
+        std::unique_ptr<DatamemberLayoutTable> table(new DatamemberLayoutTable);
+        std::vector<Cppyy::TCppScope_t> datamembers = Cppyy::GetDatamembers(scope);
+        std::vector<size_t> first_dim;
+        for (Cppyy::TCppScope_t var : datamembers) {
+            Cppyy::TCppType_t type = Cppyy::GetDatamemberType(var);
+            std::vector<long int> dims = Cppyy::GetDimensions(type);
+
+            Cppyy::DatamemberLayout dm;
+            dm.fHandle   = var;
+            dm.fName     = Cppyy::Intern(Cpp::GetName(var));
+            dm.fOffset   = Cppyy::GetDatamemberOffset(var);
+            dm.fSize     = type ? Cpp::GetSizeOfType(type) : 0;
+            dm.fDims     = nullptr;
+            dm.fNDims    = (uint32_t)dims.size();
+            dm.fIsStatic = Cppyy::IsStaticDatamember(var);
+            dm.fIsConst  = Cppyy::IsConstVar(var);
+            dm.fKind     = fastpath_kind(type);
+            table->fEntries.push_back(dm);
+
+            first_dim.push_back(table->fDims.size());
+            table->fDims.insert(table->fDims.end(), dims.begin(), dims.end());
+        }
+
+    // only now is the dimension storage final
+        for (size_t i = 0; i < table->fEntries.size(); ++i) {
+            if (table->fEntries[i].fNDims)
+                table->fEntries[i].fDims = table->fDims.data() + first_dim[i];
+        }
+        return table;
+    }
+
+    std::shared_mutex fLock;
+    std::unordered_map<Cppyy::TCppScope_t, std::unique_ptr<DatamemberLayoutTable>> fTables;
+};
+
+static DatamemberLayoutCache gDatamemberLayouts;
 
-std::vector<long int>  Cppyy::GetDimensions(TCppType_t type)
+} // unnamed namespace
+
+bool Cppyy::GetDatamemberLayout(
+    TCppScope_t scope, const DatamemberLayout*& layout, size_t& count)
 {
-    return Cpp::GetDimensions(type);
+    const DatamemberLayoutTable* table = gDatamemberLayouts.get(scope);
+    if (!table) {
+        layout = nullptr;
+        count = 0;
+        return false;
+    }
+    layout = table->fEntries.data();
+    count = table->fEntries.size();
+    return true;
 }
 
 // enum properties -----------------------------------------------------------
@@ -1881,7 +4264,9 @@ Cppyy::TCppIndex_t Cppyy::GetEnumDataValue(TCppScope_t scope)
 Cppyy::TCppScope_t Cppyy::InstantiateTemplateClass(
              TCppScope_t tmpl, Cpp::TemplateArgInfo* args, size_t args_size)
 {
-    return Cpp::InstantiateClassTemplate(tmpl, args, args_size);
+    TCppScope_t instance = Cpp::InstantiateClassTemplate(tmpl, args, args_size);
+    bump_decl_generation();
+    return instance;
 }
 
 void Cppyy::DumpScope(TCppScope_t scope)
@@ -1889,6 +4274,552 @@ void Cppyy::DumpScope(TCppScope_t scope)
     Cpp::DumpScope(scope);
 }
 
+// bulk class description ----------------------------------------------------
+// Serializes everything needed to build a class proxy into one flat record (see
+// cppyy_class_desc_t in capi.h): a header, arrays of fixed-size entries, and a
+// single table of deduplicated, null-terminated strings (offset 0 is "").
+namespace {
+
+class DescWriter {
+public:
+    DescWriter() { fStrings.push_back('\0'); fOffsets.emplace("", 0); }
+
+    uint32_t str(const std::string& s) {
+        auto it = fOffsets.find(s);
+        if (it != fOffsets.end())
+            return it->second;
+        uint32_t offset = (uint32_t)fStrings.size();
+        fStrings.append(s.c_str(), s.size()+1);
+        fOffsets.emplace(s, offset);
+        return offset;
+    }
+
+    // append the array and return its offset from the start of the record
+    template<typename T>
+    uint32_t section(const std::vector<T>& entries) {
+        align();
+        uint32_t offset = (uint32_t)fBuffer.size();
+        if (!entries.empty())
+            fBuffer.append((const char*)entries.data(), entries.size()*sizeof(T));
+        return offset;
+    }
+
+    std::string finish(cppyy_class_desc_t& hdr) {
+        align();
+        hdr.strings      = (uint32_t)fBuffer.size();
+        hdr.strings_size = (uint32_t)fStrings.size();
+        fBuffer.append(fStrings);
+        hdr.size = (uint32_t)fBuffer.size();
+        memcpy(&fBuffer[0], &hdr, sizeof(hdr));
+        return std::move(fBuffer);
+    }
+
+    void reserve_header() { fBuffer.assign(sizeof(cppyy_class_desc_t), '\0'); }
+
+private:
+    void align() { fBuffer.resize((fBuffer.size() + 7) & ~(size_t)7, '\0'); }
+
+    std::string fBuffer;
+    std::string fStrings;
+    std::unordered_map<std::string, uint32_t> fOffsets;
+};
+
+static inline
+uint32_t method_desc_flags(Cppyy::TCppMethod_t method)
+{
+    uint32_t flags = 0;
+    if (Cppyy::IsPublicMethod(method))    flags |= CPPYY_DESC_PUBLIC;
+    if (Cppyy::IsProtectedMethod(method)) flags |= CPPYY_DESC_PROTECTED;
+    if (Cppyy::IsPrivateMethod(method))   flags |= CPPYY_DESC_PRIVATE;
+    if (Cppyy::IsStaticMethod(method))    flags |= CPPYY_DESC_STATIC;
+    if (Cppyy::IsConstMethod(method))     flags |= CPPYY_DESC_CONST;
+    if (Cppyy::IsConstructor(method))     flags |= CPPYY_DESC_CONSTRUCTOR;
+    if (Cppyy::IsDestructor(method))      flags |= CPPYY_DESC_DESTRUCTOR;
+    if (Cppyy::IsDeletedMethod(method))   flags |= CPPYY_DESC_DELETED;
+    if (Cppyy::IsTemplatedMethod(method)) flags |= CPPYY_DESC_TEMPLATE;
+    return flags;
+}
+
+static inline
+uint32_t data_desc_flags(Cppyy::TCppScope_t var)
+{
+    uint32_t flags = 0;
+    if (Cppyy::IsPublicData(var))         flags |= CPPYY_DESC_PUBLIC;
+    if (Cppyy::IsProtectedData(var))      flags |= CPPYY_DESC_PROTECTED;
+    if (Cppyy::IsPrivateData(var))        flags |= CPPYY_DESC_PRIVATE;
+    if (Cppyy::IsStaticDatamember(var))   flags |= CPPYY_DESC_STATIC;
+    if (Cppyy::IsConstVar(var))           flags |= CPPYY_DESC_CONST;
+    return flags;
+}
+
+} // unnamed namespace
+
+bool Cppyy::DescribeClass(TCppScope_t scope, std::string& record)
+{
+    if (!scope)
+        return false;
+    assert_interpreter_ready();
+
+    DescWriter w;
+    w.reserve_header();
+
+    cppyy_class_desc_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic   = CPPYY_CLASS_DESC_MAGIC;
+    hdr.version = CPPYY_CLASS_DESC_VERSION;
+    hdr.scope   = (cppyy_scope_t)scope;
+    hdr.name    = w.str(GetScopedFinalName(scope));
+    if (IsNamespace(scope)) hdr.flags |= CPPYY_DESC_NAMESPACE;
+    else {
+        if (IsAbstract(scope)) hdr.flags |= CPPYY_DESC_ABSTRACT;
+        hdr.sizeof_class = (uint64_t)SizeOf(scope);
+    }
+
+// methods and their arguments
+    std::vector<cppyy_method_desc_t> methods;
+    std::vector<cppyy_arg_desc_t> args;
+    MethodSpan span;
+    std::vector<TCppMethod_t> all;
+    if (!GetClassMethodsSpan(scope, span)) {
+        all = GetClassMethods(scope);
+        span.fBegin = all.data();
+        span.fSize  = all.size();
+    }
+    for (TCppMethod_t method : span) {
+        cppyy_method_desc_t m;
+        memset(&m, 0, sizeof(m));
+        m.method    = (cppyy_method_t)method;
+        m.name      = w.str(GetMethodName(method));
+        m.rtype     = w.str(GetMethodReturnTypeAsString(method));
+        m.signature = w.str(GetMethodSignature(method, true));
+        m.flags     = method_desc_flags(method);
+        m.nargs     = (uint32_t)GetMethodNumArgs(method);
+        m.nreq      = (uint32_t)GetMethodReqArgs(method);
+        m.first_arg = (uint32_t)args.size();
+        for (uint32_t iarg = 0; iarg < m.nargs; ++iarg) {
+            cppyy_arg_desc_t a;
+            a.name     = w.str(GetMethodArgName(method, iarg));
+            a.type     = w.str(GetMethodArgTypeAsString(method, iarg));
+            a.defvalue = w.str(GetMethodArgDefault(method, iarg));
+            args.push_back(a);
+        }
+        methods.push_back(m);
+    }
+
+// data members
+    std::vector<cppyy_data_desc_t> datamembers;
+    for (TCppScope_t var : GetDatamembers(scope)) {
+        cppyy_data_desc_t d;
+        memset(&d, 0, sizeof(d));
+        d.handle = (cppyy_scope_t)var;
+        d.offset = (int64_t)GetDatamemberOffset(var);
+        d.name   = w.str(Cpp::GetName(var));
+        d.type   = w.str(GetDatamemberTypeAsString(var));
+        d.flags  = data_desc_flags(var);
+        datamembers.push_back(d);
+    }
+
+// base classes
+    std::vector<cppyy_base_desc_t> bases;
+    if (!IsNamespace(scope)) {
+        TCppIndex_t nbases = GetNumBases(scope);
+        for (TCppIndex_t ibase = 0; ibase < nbases; ++ibase) {
+            cppyy_base_desc_t b;
+            memset(&b, 0, sizeof(b));
+            b.handle = (cppyy_scope_t)GetBaseScope(scope, ibase);
+            b.name   = w.str(GetBaseName(scope, ibase));
+            bases.push_back(b);
+        }
+    }
+
+    hdr.nmethods     = (uint32_t)methods.size();
+    hdr.methods      = w.section(methods);
+    hdr.nargs        = (uint32_t)args.size();
+    hdr.args         = w.section(args);
+    hdr.ndatamembers = (uint32_t)datamembers.size();
+    hdr.datamembers  = w.section(datamembers);
+    hdr.nbases       = (uint32_t)bases.size();
+    hdr.bases        = w.section(bases);
+
+    record = w.finish(hdr);
+    return true;
+}
+
+// persistent reflection cache ---------------------------------------------
+// Class description records, stored by scoped class name in a file that other
+// processes map read-only. The file starts with a header holding a key over the
+// interpreter configuration and the contents of the dependencies (the headers)
+// that the descriptions derive from, followed by a name-sorted index and the
+// records themselves; all references in it are offsets, and the handles in the
+// stored records, which are only meaningful in the process that wrote them, are
+// zeroed. A file with a different key is ignored and replaced on save.
+namespace {
+
+const uint32_t kReflectionCacheMagic   = 0x43525043;    // "CPRC"
+const uint32_t kReflectionCacheVersion = 2;
+
+struct ReflectionCacheHeader {
+    uint32_t fMagic;
+    uint32_t fVersion;
+    uint64_t fKey;
+    uint64_t fSize;         // of the full file
+    uint64_t fNEntries;     // ReflectionCacheEntry's following the header
+};
+
+struct ReflectionCacheEntry {
+    uint64_t fName;         // offsets from the start of the file
+    uint64_t fRecord;
+    uint32_t fNameSize;
+    uint32_t fRecordSize;
+};
+
+static inline uint64_t fnv1a(uint64_t h, const char* data, size_t size)
+{
+    for (size_t i = 0; i < size; ++i) {
+        h ^= (unsigned char)data[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static void strip_handles(std::string& record)
+{
+    char* buf = &record[0];
+    cppyy_class_desc_t* hdr = (cppyy_class_desc_t*)buf;
+    hdr->scope = 0;
+    cppyy_method_desc_t* methods = (cppyy_method_desc_t*)(buf + hdr->methods);
+    for (uint32_t i = 0; i < hdr->nmethods; ++i) methods[i].method = 0;
+    cppyy_data_desc_t* datamembers = (cppyy_data_desc_t*)(buf + hdr->datamembers);
+    for (uint32_t i = 0; i < hdr->ndatamembers; ++i) datamembers[i].handle = 0;
+    cppyy_base_desc_t* bases = (cppyy_base_desc_t*)(buf + hdr->bases);
+    for (uint32_t i = 0; i < hdr->nbases; ++i) bases[i].handle = 0;
+}
+
+class ReflectionCache {
+public:
+    ~ReflectionCache() { unmap(); }
+
+    bool open(const std::string& path, const std::vector<std::string>& deps) {
+    // the flags of an interpreter created by someone else are unknown, so that
+    // records can not be shown to match its configuration
+        if (gInterpFlags.empty())
+            return false;
+
+        uint64_t key = fnv1a(0xcbf29ce484222325ULL, gInterpFlags.data(), gInterpFlags.size());
+        const char* resdir = Cpp::GetResourceDir();
+        if (resdir) key = fnv1a(key, resdir, strlen(resdir));
+        for (const std::string& dep : deps) {
+            std::ifstream f(dep, std::ios::binary);
+            if (!f.good())
+                return false;
+            std::string content((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+            key = fnv1a(key, dep.c_str(), dep.size()+1);
+            key = fnv1a(key, content.data(), content.size());
+        }
+
+        std::unique_lock<std::shared_mutex> lock(fLock);
+        unmap();
+        fPending.clear();
+        fPath = path;
+        fKey  = key;
+        fOpen = true;
+        map();
+        return true;
+    }
+
+    void close() {
+        std::unique_lock<std::shared_mutex> lock(fLock);
+        unmap();
+        fPending.clear();
+        fOpen = false;
+    }
+
+    // the record is copied out, as a save or close may unmap it at any time
+    bool find(const std::string& name, std::string& record) {
+        std::shared_lock<std::shared_mutex> lock(fLock);
+        auto pending = fPending.find(name);
+        if (pending != fPending.end()) {
+            record = pending->second;
+            return true;
+        }
+        const ReflectionCacheEntry* entry = lookup(name);
+        if (!entry)
+            return false;
+        record.assign(fData + entry->fRecord, entry->fRecordSize);
+        return true;
+    }
+
+    bool add(Cppyy::TCppScope_t scope) {
+        std::string name = Cppyy::GetScopedFinalName(scope);
+        {
+            std::shared_lock<std::shared_mutex> lock(fLock);
+            if (!fOpen)
+                return false;
+            if (fPending.find(name) != fPending.end() || lookup(name))
+                return true;
+        }
+
+        std::string record;
+        if (!Cppyy::DescribeClass(scope, record))
+            return false;
+        strip_handles(record);
+
+        std::unique_lock<std::shared_mutex> lock(fLock);
+        fPending.emplace(name, std::move(record));
+        return true;
+    }
+
+    bool save() {
+        std::unique_lock<std::shared_mutex> lock(fLock);
+        if (!fOpen)
+            return false;
+        if (fPending.empty())
+            return true;
+
+    // merge the mapped and the pending records, both in name order
+        std::map<std::string, std::pair<const char*, size_t>> all;
+        const ReflectionCacheEntry* entries = this->entries();
+        for (uint64_t i = 0; i < nentries(); ++i) {
+            all.emplace(std::string(fData + entries[i].fName, entries[i].fNameSize),
+                        std::make_pair(fData + entries[i].fRecord, (size_t)entries[i].fRecordSize));
+        }
+        for (const auto& p : fPending)
+            all[p.first] = std::make_pair(p.second.data(), p.second.size());
+
+        std::string out(sizeof(ReflectionCacheHeader) + all.size()*sizeof(ReflectionCacheEntry), '\0');
+        std::vector<ReflectionCacheEntry> index;
+        for (const auto& p : all) {
+            ReflectionCacheEntry e;
+            e.fName = out.size();
+            e.fNameSize = (uint32_t)p.first.size();
+            out.append(p.first.c_str(), p.first.size()+1);
+            out.resize((out.size() + 7) & ~(size_t)7, '\0');
+            e.fRecord = out.size();
+            e.fRecordSize = (uint32_t)p.second.second;
+            out.append(p.second.first, p.second.second);
+            out.resize((out.size() + 7) & ~(size_t)7, '\0');
+            index.push_back(e);
+        }
+
+        ReflectionCacheHeader hdr;
+        hdr.fMagic    = kReflectionCacheMagic;
+        hdr.fVersion  = kReflectionCacheVersion;
+        hdr.fKey      = fKey;
+        hdr.fSize     = out.size();
+        hdr.fNEntries = index.size();
+        memcpy(&out[0], &hdr, sizeof(hdr));
+        if (!index.empty())
+            memcpy(&out[sizeof(hdr)], index.data(), index.size()*sizeof(ReflectionCacheEntry));
+
+    // write to a private file and rename, so that readers never see a partial one
+    // (unique per writer, so that threads of one process do not collide either)
+        std::string tmp = fPath + ".XXXXXX";
+        int fd = mkstemp(&tmp[0]);
+        if (fd < 0)
+            return false;
+        bool ok = fchmod(fd, 0644) == 0 &&
+            ::write(fd, out.data(), out.size()) == (ssize_t)out.size();
+        ::close(fd);
+        if (!ok || ::rename(tmp.c_str(), fPath.c_str()) != 0) {
+            ::unlink(tmp.c_str());
+            return false;
+        }
+
+        unmap();
+        fPending.clear();
+        map();
+        return true;
+    }
+
+private:
+    void map() {
+        int fd = ::open(fPath.c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(ReflectionCacheHeader)) {
+            void* data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (data != MAP_FAILED) {
+                fData = (const char*)data;
+                fSize = (size_t)st.st_size;
+            }
+        }
+        ::close(fd);
+
+        if (fData && !valid())
+            unmap();
+    }
+
+    // a file that is stale, truncated, or otherwise damaged is a miss for all
+    bool valid() const {
+        const ReflectionCacheHeader* hdr = (const ReflectionCacheHeader*)fData;
+        if (hdr->fMagic != kReflectionCacheMagic || hdr->fVersion != kReflectionCacheVersion ||
+                hdr->fKey != fKey || hdr->fSize != fSize ||
+                hdr->fNEntries > (fSize - sizeof(*hdr))/sizeof(ReflectionCacheEntry))
+            return false;
+
+        uint64_t start = sizeof(*hdr) + hdr->fNEntries*sizeof(ReflectionCacheEntry);
+        const ReflectionCacheEntry* entries = this->entries();
+        for (uint64_t i = 0; i < hdr->fNEntries; ++i) {
+            const ReflectionCacheEntry& e = entries[i];
+            if (e.fName < start || fSize <= e.fName || fSize - e.fName <= e.fNameSize ||
+                    fData[e.fName + e.fNameSize] != '\0')
+                return false;
+            if (e.fRecord < start || fSize < e.fRecord || fSize - e.fRecord < e.fRecordSize ||
+                    e.fRecordSize < sizeof(cppyy_class_desc_t))
+                return false;
+        }
+        return true;
+    }
+
+    void unmap() {
+        if (fData) munmap((void*)fData, fSize);
+        fData = nullptr;
+        fSize = 0;
+    }
+
+    uint64_t nentries() const {
+        return fData ? ((const ReflectionCacheHeader*)fData)->fNEntries : 0;
+    }
+
+    const ReflectionCacheEntry* entries() const {
+        return (const ReflectionCacheEntry*)(fData + sizeof(ReflectionCacheHeader));
+    }
+
+    const ReflectionCacheEntry* lookup(const std::string& name) const {
+        const ReflectionCacheEntry* begin = entries();
+        const ReflectionCacheEntry* end = begin + nentries();
+        auto it = std::lower_bound(begin, end, name,
+            [this](const ReflectionCacheEntry& e, const std::string& n) {
+                return n.compare(0, std::string::npos, fData + e.fName, e.fNameSize) > 0; });
+        if (it == end || name.compare(0, std::string::npos, fData + it->fName, it->fNameSize) != 0)
+            return nullptr;
+        return it;
+    }
+
+    std::shared_mutex fLock;
+    std::string       fPath;
+    uint64_t          fKey  = 0;
+    bool              fOpen = false;
+    const char*       fData = nullptr;
+    size_t            fSize = 0;
+    std::map<std::string, std::string> fPending;
+};
+
+static ReflectionCache gReflectionCache;
+
+} // unnamed namespace
+
+bool Cppyy::OpenReflectionCache(const std::string& path, const std::vector<std::string>& deps)
+{
+    wait_for_interpreter();     // for the interpreter flags
+    return gReflectionCache.open(path, deps);
+}
+
+void Cppyy::CloseReflectionCache()
+{
+    gReflectionCache.close();
+}
+
+bool Cppyy::FindCachedClassDescription(const std::string& name, std::string& record)
+{
+    return gReflectionCache.find(name, record);
+}
+
+bool Cppyy::AddToReflectionCache(TCppScope_t scope)
+{
+    return gReflectionCache.add(scope);
+}
+
+bool Cppyy::SaveReflectionCache()
+{
+    return gReflectionCache.save();
+}
+
+// interned strings ----------------------------------------------------------
+// Strings handed out by the *_interned C entry points live as long as the
+// process, with one copy per distinct value, so that callers need not free them
+// and can compare them by pointer. Results are in addition memoized per (handle,
+// kind, index), so that repeated queries skip the reflection call entirely.
+namespace {
+
+class InternTable {
+public:
+    const char* intern(const std::string& s) {
+        {
+            std::shared_lock<std::shared_mutex> lock(fLock);
+            auto it = fStrings.find(s);
+            if (it != fStrings.end())
+                return it->c_str();
+        }
+        std::unique_lock<std::shared_mutex> lock(fLock);
+        return fStrings.insert(s).first->c_str();    // node-based: stable c_str()
+    }
+
+private:
+    std::shared_mutex fLock;
+    std::unordered_set<std::string> fStrings;
+};
+
+static InternTable gInterned;
+
+class InternMemo {
+public:
+// entries are only valid for the generation of declarations they were computed
+// in, as e.g. name resolution changes when new declarations come in
+    template<typename F>
+    const char* get(const void* handle, char kind, size_t index, F compute) {
+        Key key{handle, index, kind};
+        uint64_t generation = gDeclGeneration.load(std::memory_order_acquire);
+        {
+            std::shared_lock<std::shared_mutex> lock(fLock);
+            auto it = fMemo.find(key);
+            if (it != fMemo.end() && it->second.fGeneration == generation)
+                return it->second.fResult;
+        }
+        const char* result = gInterned.intern(compute());
+        std::unique_lock<std::shared_mutex> lock(fLock);
+        Entry& entry = fMemo[key];
+        if (!entry.fResult || entry.fGeneration <= generation)
+            entry = Entry{result, generation};
+        return result;
+    }
+
+private:
+    struct Key {
+        const void* fHandle;
+        size_t      fIndex;
+        char        fKind;
+        bool operator==(const Key& other) const {
+            return fHandle == other.fHandle && fIndex == other.fIndex && fKind == other.fKind;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            size_t h = std::hash<const void*>()(key.fHandle);
+            return h ^ (key.fIndex * 0x9e3779b97f4a7c15ULL) ^ ((size_t)key.fKind << 56);
+        }
+    };
+
+    struct Entry {
+        const char* fResult = nullptr;
+        uint64_t    fGeneration = 0;
+    };
+
+    std::shared_mutex fLock;
+    std::unordered_map<Key, Entry, KeyHash> fMemo;
+};
+
+static InternMemo gInternMemo;
+
+} // unnamed namespace
+
+const char* Cppyy::Intern(const std::string& s)
+{
+    return gInterned.intern(s);
+}
+
 //- C-linkage wrappers -------------------------------------------------------
 
 extern "C" {
@@ -1905,6 +4836,22 @@ char* cppyy_to_string(cppyy_type_t klass, cppyy_object_t obj) {
     return cppstring_to_cstring(Cppyy::ToString((Cppyy::TCppType_t) klass, obj));
 }
 
+char* cppyy_lazy_header_report() {
+    return cppstring_to_cstring(Cppyy::GetLazyHeaderReport());
+}
+
+void cppyy_startup_record(const char* phase, double start, double duration) {
+    Cppyy::RecordStartupPhase(phase, start, duration);
+}
+
+char* cppyy_startup_report() {
+    return cppstring_to_cstring(Cppyy::GetStartupReport());
+}
+
+void cppyy_start_interpreter() {
+    Cppyy::StartInterpreter();
+}
+
 
 // name to opaque C++ scope representation --------------------------------
 // char* cppyy_resolve_name(const char* cppitem_name) {
@@ -1918,10 +4865,10 @@ char* cppyy_to_string(cppyy_type_t klass, cppyy_object_t obj) {
 cppyy_scope_t cppyy_get_scope(const char* scope_name) {
     return cppyy_scope_t(Cppyy::GetScope(scope_name));
 }
-//
-// cppyy_type_t cppyy_actual_class(cppyy_type_t klass, cppyy_object_t obj) {
-//     return cppyy_type_t(Cppyy::GetActualClass(klass, (void*)obj));
-// }
+
+cppyy_type_t cppyy_actual_class(cppyy_type_t klass, cppyy_object_t obj) {
+    return cppyy_type_t(Cppyy::GetActualClass((Cppyy::TCppType_t)klass, (void*)obj));
+}
 
 size_t cppyy_size_of_klass(cppyy_type_t klass) {
     return Cppyy::SizeOf((Cppyy::TCppType_t) klass);
@@ -2087,6 +5034,111 @@ size_t cppyy_size_of_klass(cppyy_type_t klass) {
 // cppyy_funcaddr_t cppyy_function_address(cppyy_method_t method) {
 //     return cppyy_funcaddr_t(Cppyy::GetFunctionAddress(method, true));
 // }
+
+void cppyy_release_object(cppyy_type_t type, cppyy_object_t self) {
+    Cppyy::ReleaseObject((Cppyy::TCppScope_t)type, (void*)self);
+}
+
+void cppyy_object_pool_stats(size_t* allocs, size_t* reuses, size_t* releases, size_t* cached) {
+    Cppyy::GetObjectPoolStats(allocs, reuses, releases, cached);
+}
+
+/* call profiling --------------------------------------------------------- */
+void cppyy_profile_enable(int enable) {
+    Cppyy::EnableProfiling(enable);
+}
+
+cppyy_profile_t* cppyy_profile_snapshot(size_t* count) {
+    struct Total { void* fKey; bool fIsDtor; uint64_t fCalls, fTotalNs, fHist[PROFILE_BUCKETS]; };
+    std::vector<Total> totals;
+    std::map<std::pair<void*, bool>, size_t> index;
+    gProfiles.for_each([&](ProfileCounters& c) {
+        auto res = index.emplace(std::make_pair(c.fKey, c.fIsDtor), totals.size());
+        if (res.second) totals.push_back(Total{c.fKey, c.fIsDtor, 0, 0, {0}});
+        Total& t = totals[res.first->second];
+        t.fCalls   += c.fCalls.load(std::memory_order_relaxed);
+        t.fTotalNs += c.fTotalNs.load(std::memory_order_relaxed);
+        for (int i = 0; i < PROFILE_BUCKETS; ++i)
+            t.fHist[i] += c.fHist[i].load(std::memory_order_relaxed);
+    });
+
+// names are looked up outside of the registry lock
+    size_t n = 0;
+    cppyy_profile_t* entries = (cppyy_profile_t*)malloc(sizeof(cppyy_profile_t)*(totals.size() ? totals.size() : 1));
+    for (const Total& t : totals) {
+        if (!t.fCalls) continue;
+        cppyy_profile_t& e = entries[n++];
+        if (t.fIsDtor) {
+            e.name = cppstring_to_cstring(Cppyy::GetScopedFinalName(t.fKey) + "::~" + Cppyy::GetFinalName(t.fKey));
+        } else
+            e.name = cppstring_to_cstring(Cppyy::GetMethodFullName(t.fKey));
+        e.calls    = t.fCalls;
+        e.total_ns = t.fTotalNs;
+        for (int i = 0; i < PROFILE_BUCKETS; ++i)
+            e.histogram[i] = t.fHist[i];
+    }
+    *count = n;
+    return entries;
+}
+
+void cppyy_profile_free(cppyy_profile_t* entries, size_t count) {
+    for (size_t i = 0; i < count; ++i)
+        free(entries[i].name);
+    free(entries);
+}
+
+void cppyy_profile_reset() {
+    Cppyy::ResetProfile();
+}
+
+void* cppyy_call_scratch_alloc(size_t size) {
+    return Cppyy::AllocateScratch(size);
+}
+
+void cppyy_call_scratch_reset() {
+    Cppyy::ResetScratch();
+}
+
+cppyy_object_t cppyy_call_stdstring(
+        cppyy_method_t method, cppyy_object_t self, int nargs, void* args) {
+    return Cppyy::CallStdString((Cppyy::TCppMethod_t)method, self, nargs, args);
+}
+
+void cppyy_free_stdstring(cppyy_object_t str) {
+    Cppyy::FreeStdString(str);
+}
+
+size_t cppyy_call_s_buffer(cppyy_method_t method, cppyy_object_t self,
+        int nargs, void* args, char** buffer, size_t* capacity) {
+    return Cppyy::CallSBuffer((Cppyy::TCppMethod_t)method, self, nargs, args, buffer, capacity);
+}
+
+#define CPPYY_C_CALL_BATCH(typecode, ctypecode, rtype)                       \
+int cppyy_call_##ctypecode##_batch(cppyy_method_t method, cppyy_object_t* selves,\
+        int nargs, void* args, rtype* results, size_t count) {               \
+    return (int)Cppyy::Call##typecode##Batch(                                \
+        (Cppyy::TCppMethod_t)method, selves, nargs, args, results, count);   \
+}
+
+int cppyy_call_v_batch(cppyy_method_t method, cppyy_object_t* selves,
+        int nargs, void* args, size_t count) {
+    return (int)Cppyy::CallVBatch((Cppyy::TCppMethod_t)method, selves, nargs, args, count);
+}
+
+CPPYY_C_CALL_BATCH(B,  b,  unsigned char)
+CPPYY_C_CALL_BATCH(C,  c,  char         )
+CPPYY_C_CALL_BATCH(H,  h,  short        )
+CPPYY_C_CALL_BATCH(I,  i,  int          )
+CPPYY_C_CALL_BATCH(L,  l,  long         )
+CPPYY_C_CALL_BATCH(LL, ll, long long    )
+CPPYY_C_CALL_BATCH(F,  f,  float        )
+CPPYY_C_CALL_BATCH(D,  d,  double       )
+CPPYY_C_CALL_BATCH(LD, ld, long double  )
+CPPYY_C_CALL_BATCH(R,  r,  void*        )
+
+void cppyy_invalidate_callables(cppyy_method_t method) {
+    Cppyy::InvalidateCallables((Cppyy::TCppMethod_t)method);
+}
 //
 //
 // [> handling of function argument buffer ----------------------------------- <]
@@ -2113,6 +5165,49 @@ int cppyy_is_namespace(cppyy_scope_t scope) {
     return (int)Cppyy::IsNamespace((Cppyy::TCppScope_t) scope);
 }
 
+int cppyy_describe_class(cppyy_scope_t scope, char** buf, size_t* len) {
+    std::string record;
+    if (!Cppyy::DescribeClass((Cppyy::TCppScope_t)scope, record)) {
+        *buf = nullptr;
+        *len = 0;
+        return 0;
+    }
+    *buf = (char*)malloc(record.size());
+    memcpy(*buf, record.data(), record.size());
+    *len = record.size();
+    return 1;
+}
+
+int cppyy_reflection_cache_open(const char* path, const char** deps, size_t ndeps) {
+    std::vector<std::string> vdeps(deps, deps+ndeps);
+    return (int)Cppyy::OpenReflectionCache(path, vdeps);
+}
+
+void cppyy_reflection_cache_close() {
+    Cppyy::CloseReflectionCache();
+}
+
+int cppyy_reflection_cache_find(const char* name, char** buf, size_t* len) {
+    std::string record;
+    if (!Cppyy::FindCachedClassDescription(name, record)) {
+        *buf = nullptr;
+        *len = 0;
+        return 0;
+    }
+    *buf = (char*)malloc(record.size());
+    memcpy(*buf, record.data(), record.size());
+    *len = record.size();
+    return 1;
+}
+
+int cppyy_reflection_cache_add(cppyy_scope_t scope) {
+    return (int)Cppyy::AddToReflectionCache((Cppyy::TCppScope_t)scope);
+}
+
+int cppyy_reflection_cache_save() {
+    return (int)Cppyy::SaveReflectionCache();
+}
+
 // int cppyy_is_template(const char* template_name) {
 //     return (int)Cppyy::IsTemplate(template_name);
 // }
@@ -2133,18 +5228,31 @@ int cppyy_is_namespace(cppyy_scope_t scope) {
 //     return (int)Cppyy::IsDefaultConstructable(type);
 // }
 //
-// const char** cppyy_get_all_cpp_names(cppyy_scope_t scope, size_t* count) {
-//     std::set<std::string> cppnames;
-//     Cppyy::GetAllCppNames(scope, cppnames);
-//     const char** c_cppnames = (const char**)malloc(cppnames.size()*sizeof(const char*));
-//     int i = 0;
-//     for (const auto& name : cppnames) {
-//         c_cppnames[i] = cppstring_to_cstring(name);
-//         ++i;
-//     }
-//     *count = cppnames.size();
-//     return c_cppnames;
-// }
+const char** cppyy_get_all_cpp_names(cppyy_scope_t scope, size_t* count) {
+    std::set<std::string> cppnames;
+    Cppyy::GetAllCppNames((Cppyy::TCppScope_t)scope, cppnames);
+    const char** c_cppnames = (const char**)malloc(cppnames.size()*sizeof(const char*));
+    int i = 0;
+    for (const auto& name : cppnames) {
+        c_cppnames[i] = cppstring_to_cstring(name);
+        ++i;
+    }
+    *count = cppnames.size();
+    return c_cppnames;
+}
+
+cppyy_names_cursor_t cppyy_names_open(cppyy_scope_t scope, const char* prefix) {
+    return (cppyy_names_cursor_t)Cppyy::OpenNameCursor((Cppyy::TCppScope_t)scope, prefix ? prefix : "");
+}
+
+const char* cppyy_names_next(cppyy_names_cursor_t cursor) {
+    return Cppyy::NextName((Cppyy::TCppNameCursor_t)cursor);
+}
+
+void cppyy_names_close(cppyy_names_cursor_t cursor) {
+    Cppyy::CloseNameCursor((Cppyy::TCppNameCursor_t)cursor);
+}
+
 //
 //
 // [> namespace reflection information --------------------------------------- <]
@@ -2401,6 +5509,18 @@ int cppyy_is_namespace(cppyy_scope_t scope) {
 // int cppyy_get_dimension_size(cppyy_scope_t scope, cppyy_index_t idata, int dimension) {
 //     return Cppyy::GetDimensionSize(scope, idata, dimension);
 // }
+
+static_assert(sizeof(cppyy_datamember_layout_t) == sizeof(Cppyy::DatamemberLayout) &&
+              offsetof(cppyy_datamember_layout_t, dims) == offsetof(Cppyy::DatamemberLayout, fDims) &&
+              offsetof(cppyy_datamember_layout_t, ndims) == offsetof(Cppyy::DatamemberLayout, fNDims) &&
+              offsetof(cppyy_datamember_layout_t, kind) == offsetof(Cppyy::DatamemberLayout, fKind),
+              "cppyy_datamember_layout_t and Cppyy::DatamemberLayout differ");
+
+const cppyy_datamember_layout_t* cppyy_datamember_layout(cppyy_scope_t scope, size_t* count) {
+    const Cppyy::DatamemberLayout* layout = nullptr;
+    Cppyy::GetDatamemberLayout((Cppyy::TCppScope_t)scope, layout, *count);
+    return (const cppyy_datamember_layout_t*)layout;
+}
 //
 //
 // [> enum properties -------------------------------------------------------- <]
@@ -2421,6 +5541,82 @@ int cppyy_is_namespace(cppyy_scope_t scope) {
 // }
 //
 //
+// [> interned strings -------------------------------------------------------- <]
+const char* cppyy_intern(const char* str) {
+    return Cppyy::Intern(str);
+}
+
+const char* cppyy_resolve_name_interned(const char* cppitem_name) {
+// keyed on the interned input, as the name itself is not a stable handle
+    const char* name = Cppyy::Intern(cppitem_name);
+    return gInternMemo.get(name, 'R', 0, [name] { return Cppyy::ResolveName(name); });
+}
+
+const char* cppyy_final_name_interned(cppyy_type_t type) {
+    Cppyy::TCppType_t t = (Cppyy::TCppType_t)type;
+    return gInternMemo.get(t, 'F', 0, [t] { return Cppyy::GetFinalName(t); });
+}
+
+const char* cppyy_scoped_final_name_interned(cppyy_type_t type) {
+    Cppyy::TCppType_t t = (Cppyy::TCppType_t)type;
+    return gInternMemo.get(t, 'S', 0, [t] { return Cppyy::GetScopedFinalName(t); });
+}
+
+const char* cppyy_base_name_interned(cppyy_type_t type, int base_index) {
+    Cppyy::TCppType_t t = (Cppyy::TCppType_t)type;
+    return gInternMemo.get(t, 'B', (size_t)base_index,
+        [t, base_index] { return Cppyy::GetBaseName(t, (Cppyy::TCppIndex_t)base_index); });
+}
+
+const char* cppyy_method_name_interned(cppyy_method_t method) {
+    Cppyy::TCppMethod_t m = (Cppyy::TCppMethod_t)method;
+    return gInternMemo.get(m, 'n', 0, [m] { return Cppyy::GetMethodName(m); });
+}
+
+const char* cppyy_method_full_name_interned(cppyy_method_t method) {
+    Cppyy::TCppMethod_t m = (Cppyy::TCppMethod_t)method;
+    return gInternMemo.get(m, 'N', 0, [m] { return Cppyy::GetMethodFullName(m); });
+}
+
+const char* cppyy_method_result_type_interned(cppyy_method_t method) {
+    Cppyy::TCppMethod_t m = (Cppyy::TCppMethod_t)method;
+    return gInternMemo.get(m, 'r', 0, [m] { return Cppyy::GetMethodReturnTypeAsString(m); });
+}
+
+const char* cppyy_method_arg_name_interned(cppyy_method_t method, int arg_index) {
+    Cppyy::TCppMethod_t m = (Cppyy::TCppMethod_t)method;
+    return gInternMemo.get(m, 'a', (size_t)arg_index,
+        [m, arg_index] { return Cppyy::GetMethodArgName(m, (Cppyy::TCppIndex_t)arg_index); });
+}
+
+const char* cppyy_method_arg_type_interned(cppyy_method_t method, int arg_index) {
+    Cppyy::TCppMethod_t m = (Cppyy::TCppMethod_t)method;
+    return gInternMemo.get(m, 't', (size_t)arg_index,
+        [m, arg_index] { return Cppyy::GetMethodArgTypeAsString(m, (Cppyy::TCppIndex_t)arg_index); });
+}
+
+const char* cppyy_method_arg_default_interned(cppyy_method_t method, int arg_index) {
+    Cppyy::TCppMethod_t m = (Cppyy::TCppMethod_t)method;
+    return gInternMemo.get(m, 'd', (size_t)arg_index,
+        [m, arg_index] { return Cppyy::GetMethodArgDefault(m, (Cppyy::TCppIndex_t)arg_index); });
+}
+
+const char* cppyy_method_signature_interned(cppyy_method_t method, int show_formal_args) {
+    Cppyy::TCppMethod_t m = (Cppyy::TCppMethod_t)method;
+    return gInternMemo.get(m, 's', (size_t)(bool)show_formal_args,
+        [m, show_formal_args] { return Cppyy::GetMethodSignature(m, (bool)show_formal_args); });
+}
+
+const char* cppyy_datamember_name_interned(cppyy_scope_t var) {
+    Cppyy::TCppScope_t v = (Cppyy::TCppScope_t)var;
+    return gInternMemo.get(v, 'm', 0, [v] { return Cpp::GetName(v); });
+}
+
+const char* cppyy_datamember_type_interned(cppyy_scope_t var) {
+    Cppyy::TCppScope_t v = (Cppyy::TCppScope_t)var;
+    return gInternMemo.get(v, 'T', 0, [v] { return Cppyy::GetDatamemberTypeAsString(v); });
+}
+
 // [> misc helpers ----------------------------------------------------------- <]
 // RPY_EXTERN
 // void* cppyy_load_dictionary(const char* lib_name) {
@@ -2450,19 +5646,19 @@ int cppyy_is_namespace(cppyy_scope_t scope) {
 // }
 // #endif
 //
-// void cppyy_free(void* ptr) {
-//     free(ptr);
-// }
-//
+void cppyy_free(void* ptr) {
+    free(ptr);
+}
+
 // cppyy_object_t cppyy_charp2stdstring(const char* str, size_t sz) {
 //     return (cppyy_object_t)new std::string(str, sz);
 // }
 //
-// const char* cppyy_stdstring2charp(cppyy_object_t ptr, size_t* lsz) {
-//     *lsz = ((std::string*)ptr)->size();
-//     return ((std::string*)ptr)->data();
-// }
-//
+const char* cppyy_stdstring2charp(cppyy_object_t ptr, size_t* lsz) {
+    *lsz = ((std::string*)ptr)->size();
+    return ((std::string*)ptr)->data();
+}
+
 // cppyy_object_t cppyy_stdstring2stdstring(cppyy_object_t ptr) {
 //     return (cppyy_object_t)new std::string(*(std::string*)ptr);
 // }
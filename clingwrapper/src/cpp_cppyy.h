@@ -44,8 +44,16 @@ const int SMALL_ARGS_N = 8;
 
 // convention to pass flag for direct calls (similar to Python's vector calls)
 #define DIRECT_CALL ((size_t)1 << (8 * sizeof(size_t) - 1))
+
+// flag for packed argument frames: nargs 8-byte value slots, followed by nargs
+// type codes (padded to 8 bytes), instead of an array of Parameter
+#define PACKED_ARGS ((size_t)1 << (8 * sizeof(size_t) - 2))
+static inline size_t PackedFunctionArgsSize(size_t nargs) {
+    return 8*nargs + ((nargs + 7) & ~(size_t)7);
+}
+
 static inline size_t CALL_NARGS(size_t nargs) {
-    return nargs & ~DIRECT_CALL;
+    return nargs & ~(DIRECT_CALL | PACKED_ARGS);
 }
 
 // namespace cling
@@ -65,12 +73,47 @@ namespace Cppyy {
     typedef Cpp::TCppFunction_t TCppMethod_t;
     typedef Cpp::TCppIndex_t    TCppIndex_t;
     typedef intptr_t                TCppFuncAddr_t;
+    typedef void*                   TCppNameCursor_t;
+
+// flat description of a datamember, for field access by table index and pointer
+// arithmetic; kept in immutable, per-class storage (see GetDatamemberLayout)
+    struct DatamemberLayout {
+        TCppScope_t     fHandle;
+        const char*     fName;      // interned, so comparable by address
+        intptr_t        fOffset;    // address for static data
+        size_t          fSize;      // of the member's type
+        const long int* fDims;      // array dimensions, fNDims of them
+        uint32_t        fNDims;
+        bool            fIsStatic;
+        bool            fIsConst;
+        char            fKind;      // fast path classification, 0 if none
+    };
+
+// non-owning view on a cached, immutable list of methods
+    struct MethodSpan {
+        const TCppMethod_t* fBegin = nullptr;
+        size_t              fSize  = 0;
+
+        const TCppMethod_t* begin() const { return fBegin; }
+        const TCppMethod_t* end() const { return fBegin + fSize; }
+        size_t size() const { return fSize; }
+        bool empty() const { return fSize == 0; }
+        TCppMethod_t operator[](size_t i) const { return fBegin[i]; }
+    };
 
 // // direct interpreter access -------------------------------------------------
     RPY_EXPORTED
     bool Compile(const std::string& code, bool silent = false);
     RPY_EXPORTED
     std::string ToString(TCppType_t klass, TCppObject_t obj);
+    RPY_EXPORTED
+    std::string GetLazyHeaderReport();
+    RPY_EXPORTED
+    void        RecordStartupPhase(const std::string& name, double start, double duration);
+    RPY_EXPORTED
+    std::string GetStartupReport();
+    RPY_EXPORTED
+    void        StartInterpreter();
 //
 // // name to opaque C++ scope representation -----------------------------------
     RPY_EXPORTED
@@ -89,6 +132,9 @@ namespace Cppyy {
     bool AppendTypesSlow(const std::string &name,
                          std::vector<Cpp::TemplateArgInfo>& types);
     RPY_EXPORTED
+    bool AppendTypesSlow(const std::vector<std::string>& names,
+                         std::vector<std::vector<Cpp::TemplateArgInfo>>& types);
+    RPY_EXPORTED
     TCppType_t GetComplexType(const std::string &element_type);
     RPY_EXPORTED
     TCppScope_t GetScope(const std::string& scope_name,
@@ -111,7 +157,7 @@ namespace Cppyy {
     RPY_EXPORTED
     TCppScope_t GetGlobalScope();
     RPY_EXPORTED
-    TCppType_t  GetActualClass(TCppType_t klass, TCppObject_t obj) { assert(0 && "GetActualClass"); return 0; }
+    TCppType_t  GetActualClass(TCppType_t klass, TCppObject_t obj);
     RPY_EXPORTED
     size_t      SizeOf(TCppScope_t klass);
     RPY_EXPORTED
@@ -140,6 +186,10 @@ namespace Cppyy {
     TCppObject_t Construct(TCppScope_t scope, void* arena = nullptr);
     RPY_EXPORTED
     void         Destruct(TCppScope_t scope, TCppObject_t instance);
+    RPY_EXPORTED
+    void         ReleaseObject(TCppScope_t scope, TCppObject_t instance);
+    RPY_EXPORTED
+    void         GetObjectPoolStats(size_t* allocs, size_t* reuses, size_t* releases, size_t* cached);
 
 // method/function dispatching -----------------------------------------------
     RPY_EXPORTED
@@ -168,14 +218,51 @@ namespace Cppyy {
     RPY_EXPORTED
     char*         CallS(TCppMethod_t method, TCppObject_t self, size_t nargs, void* args, size_t* length);
     RPY_EXPORTED
+    TCppObject_t  CallStdString(TCppMethod_t method, TCppObject_t self, size_t nargs, void* args);
+    RPY_EXPORTED
+    void          FreeStdString(TCppObject_t str);
+    RPY_EXPORTED
+    size_t        CallSBuffer(TCppMethod_t method, TCppObject_t self, size_t nargs, void* args, char** buffer, size_t* capacity);
+    RPY_EXPORTED
     TCppObject_t  CallConstructor(TCppMethod_t method, TCppScope_t klass, size_t nargs, void* args);
     RPY_EXPORTED
     void          CallDestructor(TCppScope_t type, TCppObject_t self);
     RPY_EXPORTED
     TCppObject_t  CallO(TCppMethod_t method, TCppObject_t self, size_t nargs, void* args, TCppType_t result_type);
 
+// batched dispatching: one method over count rows of arguments and receivers;
+// false if the method could not be resolved (then nothing was called)
+    RPY_EXPORTED
+    bool CallVBatch(TCppMethod_t method, TCppObject_t* selves, size_t nargs, void* args, size_t count);
+    RPY_EXPORTED
+    bool CallBBatch(TCppMethod_t method, TCppObject_t* selves, size_t nargs, void* args, unsigned char* results, size_t count);
+    RPY_EXPORTED
+    bool CallCBatch(TCppMethod_t method, TCppObject_t* selves, size_t nargs, void* args, char* results, size_t count);
+    RPY_EXPORTED
+    bool CallHBatch(TCppMethod_t method, TCppObject_t* selves, size_t nargs, void* args, short* results, size_t count);
+    RPY_EXPORTED
+    bool CallIBatch(TCppMethod_t method, TCppObject_t* selves, size_t nargs, void* args, int* results, size_t count);
+    RPY_EXPORTED
+    bool CallLBatch(TCppMethod_t method, TCppObject_t* selves, size_t nargs, void* args, long* results, size_t count);
+    RPY_EXPORTED
+    bool CallLLBatch(TCppMethod_t method, TCppObject_t* selves, size_t nargs, void* args, PY_LONG_LONG* results, size_t count);
+    RPY_EXPORTED
+    bool CallFBatch(TCppMethod_t method, TCppObject_t* selves, size_t nargs, void* args, float* results, size_t count);
+    RPY_EXPORTED
+    bool CallDBatch(TCppMethod_t method, TCppObject_t* selves, size_t nargs, void* args, double* results, size_t count);
+    RPY_EXPORTED
+    bool CallLDBatch(TCppMethod_t method, TCppObject_t* selves, size_t nargs, void* args, PY_LONG_DOUBLE* results, size_t count);
+    RPY_EXPORTED
+    bool CallRBatch(TCppMethod_t method, TCppObject_t* selves, size_t nargs, void* args, void** results, size_t count);
+
     RPY_EXPORTED
     TCppFuncAddr_t GetFunctionAddress(TCppMethod_t method, bool check_enabled=true);
+    RPY_EXPORTED
+    void          InvalidateCallables(TCppMethod_t method = nullptr);
+    RPY_EXPORTED
+    void          EnableProfiling(bool enable);
+    RPY_EXPORTED
+    void          ResetProfile();
 
 // // handling of function argument buffer --------------------------------------
     RPY_EXPORTED
@@ -186,6 +273,14 @@ namespace Cppyy {
     size_t GetFunctionArgSizeof();
     RPY_EXPORTED
     size_t GetFunctionArgTypeoffset();
+    RPY_EXPORTED
+    void*  AllocateScratch(size_t size);
+    RPY_EXPORTED
+    void   ResetScratch();
+    RPY_EXPORTED
+    void*  AllocatePackedFunctionArgs(size_t nargs);
+    RPY_EXPORTED
+    size_t GetPackedFunctionArgsSize(size_t nargs);
 
 // // scope reflection information ----------------------------------------------
     RPY_EXPORTED
@@ -214,7 +309,13 @@ namespace Cppyy {
     bool IsVariable(TCppScope_t scope);
 
     RPY_EXPORTED
-    void GetAllCppNames(TCppScope_t scope, std::set<std::string>& cppnames) { return; }
+    void GetAllCppNames(TCppScope_t scope, std::set<std::string>& cppnames);
+    RPY_EXPORTED
+    TCppNameCursor_t OpenNameCursor(TCppScope_t scope, const std::string& prefix = "");
+    RPY_EXPORTED
+    const char* NextName(TCppNameCursor_t cursor);
+    RPY_EXPORTED
+    void CloseNameCursor(TCppNameCursor_t cursor);
 
 // // namespace reflection information ------------------------------------------
     RPY_EXPORTED
@@ -258,6 +359,11 @@ namespace Cppyy {
     RPY_EXPORTED
     std::vector<TCppScope_t> GetMethodsFromName(TCppScope_t scope,
                                                 const std::string& name);
+// copy-free variants for completed classes (false otherwise); spans stay valid
+    RPY_EXPORTED
+    bool GetClassMethodsSpan(TCppScope_t scope, MethodSpan& span);
+    RPY_EXPORTED
+    bool GetMethodsFromNameSpan(TCppScope_t scope, const std::string& name, MethodSpan& span);
 
     RPY_EXPORTED
     TCppMethod_t GetMethod(TCppScope_t scope, TCppIndex_t imeth) { return 0; }
@@ -362,6 +468,8 @@ namespace Cppyy {
 //     bool IsEnumData(TCppScope_t scope, TCppIndex_t idata);
     RPY_EXPORTED
     std::vector<long int> GetDimensions(TCppType_t type);
+    RPY_EXPORTED
+    bool GetDatamemberLayout(TCppScope_t scope, const DatamemberLayout*& layout, size_t& count);
 
 // // enum properties -----------------------------------------------------------
     // GetEnum is unused.
@@ -383,6 +491,26 @@ namespace Cppyy {
 
     RPY_EXPORTED
     void        DumpScope(TCppScope_t scope);
+
+// // bulk class description (record layout: cppyy_class_desc_t in capi.h) -----
+    RPY_EXPORTED
+    bool        DescribeClass(TCppScope_t scope, std::string& record);
+
+// // persistent reflection cache of class description records -----------------
+    RPY_EXPORTED
+    bool        OpenReflectionCache(const std::string& path, const std::vector<std::string>& deps);
+    RPY_EXPORTED
+    void        CloseReflectionCache();
+    RPY_EXPORTED
+    bool        FindCachedClassDescription(const std::string& name, std::string& record);
+    RPY_EXPORTED
+    bool        AddToReflectionCache(TCppScope_t scope);
+    RPY_EXPORTED
+    bool        SaveReflectionCache();
+
+// // interned strings: one process-lifetime copy per distinct value -----------
+    RPY_EXPORTED
+    const char* Intern(const std::string& s);
 } // namespace Cppyy
 
 
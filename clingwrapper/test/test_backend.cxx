@@ -0,0 +1,216 @@
+// Regression tests of the backend, run against a live interpreter; each test
+// declares its own code in a namespace of its own.
+//
+// usage: cppyy-backend-test
+
+// Bindings
+#include "capi.h"
+#include "cpp_cppyy.h"
+
+// Standard
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+// test driver ---------------------------------------------------------------
+static int gFailures = 0;
+
+#define CPPYY_CHECK(cond)                                                    \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);\
+            ++gFailures;                                                     \
+        }                                                                    \
+    } while (0)
+
+static Cppyy::TCppMethod_t find_method(Cppyy::TCppScope_t scope, const std::string& name)
+{
+    std::vector<Cppyy::TCppMethod_t> methods = Cppyy::GetMethodsFromName(scope, name);
+    return methods.empty() ? nullptr : methods[0];
+}
+
+
+// batch calls ---------------------------------------------------------------
+static void test_batch_scratch()
+{
+// by-reference temporaries of all rows must stay alive for the full batch, also
+// when they span more than one chunk of the scratch arena
+    CPPYY_CHECK(Cppyy::Compile(
+        "namespace cppyy_test_batch {\n"
+        "struct Big { double fData[375]; };\n"
+        "double twice(const Big& b) { return 2*b.fData[374]; }\n"
+        "}"));
+    Cppyy::TCppScope_t scope = Cppyy::GetScope("cppyy_test_batch");
+    Cppyy::TCppScope_t big = Cppyy::GetScope("Big", scope);
+    Cppyy::TCppMethod_t m = find_method(scope, "twice");
+    CPPYY_CHECK(big && m);
+    if (!big || !m) return;
+
+    const size_t nrows = 5;
+    size_t size = Cppyy::SizeOf(big);
+    std::vector<Parameter> rows(nrows);
+    void* first = nullptr;
+    for (size_t i = 0; i < nrows; ++i) {
+        double* data = (double*)Cppyy::AllocateScratch(size);
+        if (!first) first = data;
+        for (size_t k = 0; k < size/sizeof(double); ++k)
+            data[k] = (double)(i+1);
+        rows[i].fValue.fVoidp = data;
+        rows[i].fTypeCode = 'T';
+    }
+
+    double results[nrows];
+    CPPYY_CHECK(Cppyy::CallDBatch(m, nullptr, 1, rows.data(), results, nrows));
+    for (size_t i = 0; i < nrows; ++i)
+        CPPYY_CHECK(results[i] == 2.*(i+1));
+
+// all temporaries are released once the batch is done
+    CPPYY_CHECK(Cppyy::AllocateScratch(size) == first);
+    Cppyy::ResetScratch();
+}
+
+
+// base offsets --------------------------------------------------------------
+static void test_nonpublic_base_offset()
+{
+// private and protected non-virtual bases are found through reflection, both for
+// plain classes and for dynamic ones (which go through a JIT-ed cast)
+    CPPYY_CHECK(Cppyy::Compile(
+        "namespace cppyy_test_offsets {\n"
+        "struct Pad { long fPad = 1; };\n"
+        "struct Base { long fBase = 2; };\n"
+        "struct Private : private Pad, private Base {\n"
+        "  static long offset(Private* p) { return (char*)static_cast<Base*>(p) - (char*)p; }\n"
+        "};\n"
+        "struct Protected : protected Pad, protected Base {\n"
+        "  virtual ~Protected() {}\n"
+        "  static long offset(Protected* p) { return (char*)static_cast<Base*>(p) - (char*)p; }\n"
+        "};\n"
+        "}"));
+    Cppyy::TCppScope_t scope = Cppyy::GetScope("cppyy_test_offsets");
+    Cppyy::TCppScope_t base = Cppyy::GetScope("Base", scope);
+    CPPYY_CHECK(base);
+
+    for (const char* name : {"Private", "Protected"}) {
+        Cppyy::TCppScope_t derived = Cppyy::GetScope(name, scope);
+        Cppyy::TCppMethod_t m = derived ? find_method(derived, "offset") : nullptr;
+        CPPYY_CHECK(derived && m);
+        if (!base || !derived || !m) continue;
+
+        Cppyy::TCppObject_t obj = Cppyy::Construct(derived);
+        Parameter arg;
+        arg.fValue.fVoidp = obj;
+        arg.fTypeCode = 'p';
+        ptrdiff_t expected = (ptrdiff_t)Cppyy::CallL(m, nullptr, 1, &arg);
+        CPPYY_CHECK(expected != 0);
+
+        CPPYY_CHECK(Cppyy::GetBaseOffset(derived, base, obj, 1, true) == expected);
+        CPPYY_CHECK(Cppyy::GetBaseOffset(derived, base, (char*)obj + expected, -1, true) == -expected);
+        CPPYY_CHECK(Cppyy::GetBaseOffset(derived, base, nullptr, 1, true) == expected);
+        Cppyy::Destruct(derived, obj);
+    }
+}
+
+
+// object pool ---------------------------------------------------------------
+static void test_unpooled_by_value_result()
+{
+// by-value results of classes with their own operator new do not come from the
+// pool, and are freed through Deallocate
+    CPPYY_CHECK(Cppyy::Compile(
+        "namespace cppyy_test_pool {\n"
+        "struct Custom {\n"
+        "  static void* operator new(size_t sz) { return ::operator new(sz); }\n"
+        "  static void operator delete(void* p) { ::operator delete(p); }\n"
+        "  long fData[4];\n"
+        "};\n"
+        "Custom make() { Custom c; c.fData[3] = 42; return c; }\n"
+        "}"));
+    Cppyy::TCppScope_t scope = Cppyy::GetScope("cppyy_test_pool");
+    Cppyy::TCppScope_t custom = Cppyy::GetScope("Custom", scope);
+    Cppyy::TCppMethod_t m = find_method(scope, "make");
+    CPPYY_CHECK(custom && m);
+    if (!custom || !m) return;
+
+    size_t allocs = 0, after = 0;
+    Cppyy::GetObjectPoolStats(&allocs, nullptr, nullptr, nullptr);
+    Cppyy::TCppObject_t obj = Cppyy::CallO(m, nullptr, 0, nullptr, Cppyy::GetTypeFromScope(custom));
+    Cppyy::GetObjectPoolStats(&after, nullptr, nullptr, nullptr);
+    CPPYY_CHECK(obj && ((long*)obj)[3] == 42);
+    CPPYY_CHECK(after == allocs);
+    if (!obj) return;
+
+    Cppyy::CallDestructor(custom, obj);
+    Cppyy::Deallocate(custom, obj);
+}
+
+
+// method templates ----------------------------------------------------------
+static void test_overloaded_method_templates()
+{
+// the prototype selects among templates of the same name; a prototype that no
+// template accepts gives no method at all
+    CPPYY_CHECK(Cppyy::Compile(
+        "namespace cppyy_test_templates {\n"
+        "template<class T> int pick(T, int) { return 1; }\n"
+        "template<class T> int pick(T, const char*) { return 2; }\n"
+        "struct NoMatch {};\n"
+        "}"));
+    Cppyy::TCppScope_t scope = Cppyy::GetScope("cppyy_test_templates");
+    CPPYY_CHECK(scope);
+    if (!scope) return;
+
+    Cppyy::TCppMethod_t m_int = Cppyy::GetMethodTemplate(scope, "pick<double>", "double,int");
+    Cppyy::TCppMethod_t m_str = Cppyy::GetMethodTemplate(scope, "pick<double>", "double,const char*");
+    CPPYY_CHECK(m_int && m_str && m_int != m_str);
+    CPPYY_CHECK(!Cppyy::GetMethodTemplate(scope, "pick<double>", "double,cppyy_test_templates::NoMatch"));
+    if (!m_int || !m_str) return;
+
+    Parameter args[2];
+    args[0].fValue.fDouble = 1.;
+    args[0].fTypeCode = 'd';
+    args[1].fValue.fInt = 0;
+    args[1].fTypeCode = 'i';
+    CPPYY_CHECK(Cppyy::CallI(m_int, nullptr, 2, args) == 1);
+    args[1].fValue.fVoidp = (void*)"";
+    args[1].fTypeCode = 'p';
+    CPPYY_CHECK(Cppyy::CallI(m_str, nullptr, 2, args) == 2);
+}
+
+static void test_method_template_args()
+{
+// integral template arguments are values, not types; without a prototype, only
+// a single template of the name can be instantiated
+    CPPYY_CHECK(Cppyy::Compile(
+        "namespace cppyy_test_template_args {\n"
+        "template<int N, class T> int scaled(T x) { return N*x; }\n"
+        "template<class T> int twice(T x) { return 2*x; }\n"
+        "}"));
+    Cppyy::TCppScope_t scope = Cppyy::GetScope("cppyy_test_template_args");
+    CPPYY_CHECK(scope);
+    if (!scope) return;
+
+    Parameter arg;
+    arg.fValue.fInt = 7;
+    arg.fTypeCode = 'i';
+    Cppyy::TCppMethod_t m_scaled = Cppyy::GetMethodTemplate(scope, "scaled<3,int>", "int");
+    CPPYY_CHECK(m_scaled && Cppyy::CallI(m_scaled, nullptr, 1, &arg) == 21);
+    Cppyy::TCppMethod_t m_twice = Cppyy::GetMethodTemplate(scope, "twice<int>", "");
+    CPPYY_CHECK(m_twice && Cppyy::CallI(m_twice, nullptr, 1, &arg) == 14);
+    CPPYY_CHECK(!Cppyy::GetMethodTemplate(Cppyy::GetScope("cppyy_test_templates"), "pick<double>", ""));
+}
+
+
+int main()
+{
+    test_batch_scratch();
+    test_nonpublic_base_offset();
+    test_unpooled_by_value_result();
+    test_overloaded_method_templates();
+    test_method_template_args();
+
+    if (gFailures)
+        fprintf(stderr, "cppyy-backend-test: %d check(s) failed\n", gFailures);
+    return gFailures ? 1 : 0;
+}
@@ -9,12 +9,16 @@ __all__ = [
 ]
 
 import ctypes
+import hashlib
+import json
 import os
 import platform
 import re
 import subprocess
 import sys
 import sysconfig
+import threading
+import time
 import warnings
 
 if 'win32' in sys.platform:
@@ -72,14 +76,47 @@ def _load_helper(bkname):
     return None, errors
 
 
+# startup phases as (name, start, duration), with times in seconds since the
+# epoch; handed to the backend once loaded (see cppyy_startup_report)
+_startup_phases = list()
+def _timed(name, func, *args):
+    start = time.time()
+    try:
+        return func(*args)
+    finally:
+        _startup_phases.append((name, start, time.time()-start))
+
+def _report_startup_phases(c):
+    try:
+        record = c.cppyy_startup_record
+    except AttributeError:
+        return                      # older backend
+    record.argtypes = [ctypes.c_char_p, ctypes.c_double, ctypes.c_double]
+    record.restype = None
+    for name, start, duration in _startup_phases:
+        record(name.encode(), start, duration)
+    del _startup_phases[:]
+
+def _start_interpreter(c):
+  # with CPPYY_ASYNC_INIT, have the interpreter initialize while the import of
+  # cppyy continues; this must wait until the library is loaded (see capi.h)
+    try:
+        start = c.cppyy_start_interpreter
+    except AttributeError:
+        return                      # older backend
+    start.argtypes = []
+    start.restype = None
+    start()
+
+
 _precompiled_header_ensured = False
 def load_cpp_backend():
-    set_cling_compile_options()
+    _timed('set_cling_compile_options', set_cling_compile_options)
 
     if not _precompiled_header_ensured:
      # the precompiled header of standard and system headers is not part of the
      # distribution as there are too many varieties; create it now if needed
-        ensure_precompiled_header()
+        _timed('ensure_precompiled_header', ensure_precompiled_header)
 
     names = list()
     try:
@@ -96,7 +133,7 @@ def load_cpp_backend():
 
     err = set()
     for name in names:
-        c, err2 = _load_helper(name)
+        c, err2 = _timed('load library '+name, _load_helper, name)
         if c:
             break
         err = err.union(err2)
@@ -105,6 +142,8 @@ def load_cpp_backend():
         raise RuntimeError("could not load cppyy_backend library, details:\n%s" %
             '\n'.join(['  '+x for x in err]))
 
+    _report_startup_phases(c)
+    _start_interpreter(c)
     return c
 
 
@@ -153,7 +192,69 @@ def _warn_no_pch(msg, pchname=None):
     else:
         warnings.warn('Precompiled header may be out of date (%s).' % msg)
 
-def _is_uptodate(pchname, incpath):
+def _include_fingerprint(incpath):
+  # cheap summary of the include tree: the names of all entries and the stat info
+  # of the directories, which change when headers are added, removed, or replaced
+  # (as installers do); files themselves are not stat'ed
+    h = hashlib.sha256()
+    for root, dirs, fnames in os.walk(incpath):
+        dirs.sort()
+        st = os.stat(root)
+        relroot = os.path.relpath(root, incpath).replace(os.sep, '/')
+        h.update(('%s\0%d\0%r\0' % (relroot, st.st_ino, st.st_mtime)).encode('utf-8'))
+        for fname in sorted(fnames):
+            h.update((fname+'\0').encode('utf-8'))
+    return h.hexdigest()
+
+def _header_manifest(incpath, previous=None):
+  # content hashes of all headers under incpath, keyed by relative path; files
+  # of which size and mtime match the previous manifest are not read again
+    if previous is None:
+        previous = dict()
+    files = dict()
+    for root, dirs, fnames in os.walk(incpath):
+        for fname in fnames:
+            fpath = os.path.join(root, fname)
+            relpath = os.path.relpath(fpath, incpath).replace(os.sep, '/')
+            st = os.stat(fpath)
+            old = previous.get(relpath)
+            if old and old[0] == st.st_size and old[1] == st.st_mtime:
+                files[relpath] = old
+                continue
+            h = hashlib.sha256()
+            with open(fpath, 'rb') as f:
+                for chunk in iter(lambda: f.read(1 << 20), b''):
+                    h.update(chunk)
+            files[relpath] = [st.st_size, st.st_mtime, h.hexdigest()]
+    return files
+
+def _read_manifest(pchname):
+    try:
+        with open(pchname+'.manifest', 'r') as f:
+            return json.load(f)
+    except Exception:
+        return None
+
+_manifest_warned = False
+def _write_manifest(pchname, flags, files, fingerprint):
+    global _manifest_warned
+    tmpname = '%s.manifest.%d' % (pchname, os.getpid())
+    try:
+        with open(tmpname, 'w') as f:
+            json.dump({'flags': flags, 'files': files, 'fingerprint': fingerprint}, f, sort_keys=True)
+        getattr(os, 'replace', os.rename)(tmpname, pchname+'.manifest')
+    except Exception as e:
+        try:
+            os.remove(tmpname)
+        except Exception:
+            pass
+      # not fatal, but headers will be rehashed on every start until it is fixed
+        if not _manifest_warned:
+            _manifest_warned = True
+            warnings.warn('Can not update the manifest of precompiled header %s (%s); set '
+                          'CLING_STANDARD_PCH to a writable location to speed up startup.' % (pchname, e))
+
+def _is_uptodate(pchname, incpath, flags='', writable=True):
   # check for forced rebuild
     force_rebuild = os.environ.get('CLING_REBUILD_PCH', '')
     if force_rebuild == '1' or force_rebuild.lower() == 'true':
@@ -165,15 +266,108 @@ def _is_uptodate(pchname, incpath):
       # okay if PCH is available, no point to rebuild if include dir is not
         return os.path.exists(pchname) or not os.path.exists(incpath)
 
-  # test whether the pch is older than the include directory as a crude way
-  # to find if it's up to date
+    if not os.path.exists(pchname):
+        return False
+    if not os.path.exists(incpath):
+        return True     # no point in updating as it will fail
+
+  # compare the compiler flags and header contents with the ones that the PCH was
+  # built from, as recorded in its manifest; if the include tree still has the
+  # recorded fingerprint, the headers are taken as is, otherwise their contents
+  # are compared, with time stamps only used to skip rehashing, as they do not
+  # survive copies and container layer extraction
+    manifest = _read_manifest(pchname)
     try:
-        return os.stat(pchname).st_mtime >= os.stat(incpath).st_mtime
+        if manifest is None:
+          # no manifest (PCH from an older version, or packaged): fall back to
+          # comparing the time stamps, and record a manifest if the PCH is accepted
+          # and its location is writable; otherwise, the time stamps are all there
+          # is, as hashing the headers could not be recorded and would be repeated
+          # on every start
+            if os.stat(pchname).st_mtime < os.stat(incpath).st_mtime:
+                return False
+            if writable:
+                _write_manifest(pchname, flags, _header_manifest(incpath), _include_fingerprint(incpath))
+            return True
+
+        if manifest.get('flags') != flags:
+            return False
+        fingerprint = _include_fingerprint(incpath)
+        if manifest.get('fingerprint') == fingerprint:
+            return True
+        if not writable:
+            return os.stat(incpath).st_mtime <= os.stat(pchname).st_mtime
+        previous = manifest.get('files', dict())
+        files = _header_manifest(incpath, previous)
+        if sorted((k, v[2]) for k, v in files.items()) != \
+           sorted((k, v[2]) for k, v in previous.items()):
+            return False
+        _write_manifest(pchname, flags, files, fingerprint)   # refresh stat info and fingerprint
+        return True
     except Exception:
-        if not os.path.exists(incpath):
-            return True     # no point in updating as it will fail
+        pass
     return False
 
+class _FileLock(object):
+  # exclusive lock on an auxiliary file, to serialize PCH builds across processes
+    def __init__(self, fname):
+        self.fname = fname
+        self.fd = None
+
+    def __enter__(self):
+        self.fd = os.open(self.fname, os.O_RDWR | os.O_CREAT, 0o666)
+        if 'win32' in sys.platform:
+            import msvcrt
+            while True:
+                try:
+                    msvcrt.locking(self.fd, msvcrt.LK_LOCK, 1)
+                    break
+                except OSError:
+                    pass                    # LK_LOCK gives up after 10s; keep waiting
+        else:
+            import fcntl
+            fcntl.flock(self.fd, fcntl.LOCK_EX)
+        return self
+
+    def __exit__(self, *args):
+        try:
+            if 'win32' in sys.platform:
+                import msvcrt
+                os.lseek(self.fd, 0, os.SEEK_SET)
+                msvcrt.locking(self.fd, msvcrt.LK_UNLCK, 1)
+            else:
+                import fcntl
+                fcntl.flock(self.fd, fcntl.LOCK_UN)
+        finally:
+            os.close(self.fd)
+
+def _build_pch(pkgpath, pchname, incpath, cling_args):
+  # build a single PCH variant with the given flags, unless another process did
+  # so while this one was waiting for the lock
+    try:
+        with _FileLock(pchname+'.lock'):
+            _build_pch_locked(pkgpath, pchname, incpath, cling_args)
+    except Exception as e:
+        _warn_no_pch(str(e), pchname)
+
+def _build_pch_locked(pkgpath, pchname, incpath, cling_args):
+    if os.path.exists(pchname) and _is_uptodate(pchname, incpath, cling_args):
+        return
+
+    print('(Re-)building pre-compiled headers (options:%s); this may take a minute ...' % (cling_args or ' none'))
+    makepch = os.path.join(pkgpath, 'etc', 'dictpch', 'makepch.py')
+    pyexe = sys.executable
+    if getattr(sys, 'frozen', False) or not ('python' in pyexe.lower() or 'pypy' in pyexe.lower()):
+      # either frozen, or a high chance of being embedded; and the actual version
+      # of python used doesn't matter per se, as long as it is functional
+        pyexe = 'python'
+    env = dict(os.environ)
+    env['EXTRA_CLING_ARGS'] = cling_args
+    if subprocess.call([pyexe, makepch, pchname, '-I'+incpath], cwd=pkgpath, env=env) != 0:
+        _warn_no_pch('failed to build', pchname)
+    else:
+        _write_manifest(pchname, cling_args, _header_manifest(incpath), _include_fingerprint(incpath))
+
 def ensure_precompiled_header(pchdir = '', pchname = ''):
   # the precompiled header of standard and system headers is not part of the
   # distribution as there are too many varieties; create it now if needed
@@ -216,33 +410,32 @@ def ensure_precompiled_header(pchdir = '', pchname = ''):
          os.chdir(pkgpath)
          incpath = os.path.join(pkgpath, 'include')
 
+         writable = os.access(pchdir, os.R_OK|os.W_OK)
+         builds = list()
          for ext, ext_flags in specialize:
              pchname1 = pchname+ext
+             cling_args1 = cling_args
+             if ext_flags:
+                 if 'device' in ext_flags:    # TODO: find cleaner way
+                     cling_args1 = cling_args1.replace(' -march=native', '')
+                 cling_args1 += ext_flags
              pch_exists = os.path.exists(pchname1)
-             if not pch_exists or not _is_uptodate(pchname1, incpath):
-                 if os.access(pchdir, os.R_OK|os.W_OK):
-                     if ext_flags:
-                         eca_old1 = eca_old = os.environ.get('EXTRA_CLING_ARGS', '')
-                         if 'device' in ext_flags:    # TODO: find cleaner way
-                             eca_old1 = eca_old1.replace(' -march=native', '')
-                         os.environ['EXTRA_CLING_ARGS'] = eca_old1 + ext_flags
-                     print('(Re-)building pre-compiled headers (options:%s); this may take a minute ...' % os.environ.get('EXTRA_CLING_ARGS', ' none'))
-                     makepch = os.path.join(pkgpath, 'etc', 'dictpch', 'makepch.py')
-                     pyexe = sys.executable
-                     if getattr(sys, 'frozen', False) or not ('python' in pyexe.lower() or 'pypy' in pyexe.lower()):
-                       # either frozen, or a high chance of being embedded; and the actual version
-                       # of python used doesn't matter per se, as long as it is functional
-                         pyexe = 'python'
-                     if subprocess.call([pyexe, makepch, pchname1, '-I'+incpath]) != 0:
-                         _warn_no_pch('failed to build', pchname1)
-                     if ext_flags:
-                        os.environ['EXTRA_CLING_ARGS'] = eca_old
+             if not pch_exists or not _is_uptodate(pchname1, incpath, cling_args1, writable):
+                 if writable:
+                     builds.append((pchname1, cling_args1))
                  elif not pch_exists:
                    # accept that the file may be out of date; since the location is not writable,
                    # the most likely cause is that it is managed by some packager, which in that
                    # case is responsible for the PCH, so only warn if it doesn't exist
                       _warn_no_pch('%s not writable, set CLING_STANDARD_PCH' % pchdir, pchname1)
 
+       # the variants (e.g. CUDA host and device) are independent, so build them
+       # concurrently; each holds a lock on its own PCH for the duration
+         threads = [threading.Thread(target=_build_pch, args=(pkgpath, name, incpath, args))
+                    for name, args in builds]
+         for t in threads: t.start()
+         for t in threads: t.join()
+
      except Exception as e:
          _warn_no_pch(str(e))
      finally: